@@ -0,0 +1,178 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "AudioRenderer.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <numbers>
+#include <thread>
+
+FMorseAudioRenderer::FMorseAudioRenderer(const FToneSettings& InSettings)
+    : Settings(InSettings)
+    , UnitSamples(static_cast<uint32>(std::lround(static_cast<float64>(InSettings.SampleRate) * 1.2 / InSettings.Wpm)))
+{
+    checkf(Settings.SampleRate >= 8000 && Settings.SampleRate <= 48000, "Sample rate has to be between 8 and 48 kHz")
+    checkf(UnitSamples >= Simd::float32_8::GetNumElements(), "Words per minute too high for the sample rate")
+
+    DotEnvelope = MakeEnvelope(1);
+    DashEnvelope = MakeEnvelope(3);
+}
+
+std::vector<Simd::float32_8> FMorseAudioRenderer::MakeEnvelope(const uint64 NumUnits) const
+{
+    constexpr size_t NumLanes{Simd::float32_8::GetNumElements()};
+
+    const size_t NumSamples{static_cast<size_t>(NumUnits * UnitSamples)};
+    const size_t EdgeSamples{std::min(static_cast<size_t>(Settings.EdgeSeconds * static_cast<float32>(Settings.SampleRate)), NumSamples / 2)};
+
+    //the tail past the last sample stays zero so whole registers can be written over the start of the following gap
+    std::vector<float32> Envelope((NumSamples + NumLanes - 1) / NumLanes * NumLanes, 0.f);
+
+    for(size_t Sample{0}; Sample < NumSamples; ++Sample)
+    {
+        const size_t DistanceToEdge{std::min(Sample, NumSamples - 1 - Sample)};
+
+        Envelope[Sample] = DistanceToEdge >= EdgeSamples ? 1.f : 0.5f - 0.5f * std::cos(std::numbers::pi_v<float32> * static_cast<float32>(DistanceToEdge) / static_cast<float32>(EdgeSamples));
+    }
+
+    std::vector<Simd::float32_8> Registers(Envelope.size() / NumLanes);
+
+    for(size_t Register{0}; Register < Registers.size(); ++Register)
+    {
+        Registers[Register] = Simd::float32_8{_mm256_loadu_ps(&Envelope[Register * NumLanes])};
+    }
+
+    return Registers;
+}
+
+FPcmAudio FMorseAudioRenderer::Render(const FKeyingStream& Stream) const
+{
+    constexpr size_t NumLanes{Simd::float32_8::GetNumElements()};
+
+    FPcmAudio Audio{};
+    Audio.SampleRate = Settings.SampleRate;
+    Audio.NumChannels = 1;
+
+    //one unit of silence at the end so the last element is not cut by players
+    const size_t NumSamples{static_cast<size_t>((Stream.NumUnits + 1) * UnitSamples)};
+
+    Audio.Samples.resize(NumSamples + NumLanes, 0);
+
+    const float64 RadiansPerSample{2.0 * std::numbers::pi * Settings.ToneFrequency / Settings.SampleRate};
+
+    const Simd::float32_8 StepCosine{static_cast<float32>(std::cos(RadiansPerSample * NumLanes))};
+    const Simd::float32_8 StepSine{static_cast<float32>(std::sin(RadiansPerSample * NumLanes))};
+    const Simd::float32_8 Scale{Settings.Amplitude * 32767.f};
+
+    std::vector<Simd::float32_8> OtherEnvelope{};
+
+    uint64 Unit{0};
+
+    while(Unit < Stream.NumUnits)
+    {
+        if(((Stream.Words[Unit / 64] >> (Unit % 64)) & 1) == 0)
+        {
+            ++Unit;
+            continue;
+        }
+
+        const uint64 RunStart{Unit};
+
+        while(Unit < Stream.NumUnits && ((Stream.Words[Unit / 64] >> (Unit % 64)) & 1) != 0)
+        {
+            ++Unit;
+        }
+
+        const uint64 RunUnits{Unit - RunStart};
+
+        if unlikely(RunUnits != 1 && RunUnits != 3)
+        {
+            OtherEnvelope = MakeEnvelope(RunUnits);
+        }
+
+        const std::vector<Simd::float32_8>& Envelope{RunUnits == 1 ? DotEnvelope : RunUnits == 3 ? DashEnvelope : OtherEnvelope};
+
+        //the oscillator is restarted at the exact phase of the first sample, so long files do not accumulate rotation error
+        const size_t FirstSample{static_cast<size_t>(RunStart * UnitSamples)};
+        const float64 StartPhase{std::fmod(RadiansPerSample * static_cast<float64>(FirstSample), 2.0 * std::numbers::pi)};
+
+        alignas(Simd::float32_8) std::array<float32, NumLanes> Cosines{};
+        alignas(Simd::float32_8) std::array<float32, NumLanes> Sines{};
+
+        for(size_t Lane{0}; Lane < NumLanes; ++Lane)
+        {
+            Cosines[Lane] = static_cast<float32>(std::cos(StartPhase + RadiansPerSample * Lane));
+            Sines[Lane] = static_cast<float32>(std::sin(StartPhase + RadiansPerSample * Lane));
+        }
+
+        Simd::float32_8 Cosine{_mm256_load_ps(Cosines.data())};
+        Simd::float32_8 Sine{_mm256_load_ps(Sines.data())};
+
+        int16* Out{&Audio.Samples[FirstSample]};
+
+        for(const Simd::float32_8& EnvelopeRegister : Envelope)
+        {
+            const Simd::float32_8 Tone{Sine * EnvelopeRegister * Scale};
+            const __m256i Integers{_mm256_cvtps_epi32(Tone.Register)};
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(Out), _mm_packs_epi32(_mm256_castsi256_si128(Integers), _mm256_extracti128_si256(Integers, 1)));
+            Out += NumLanes;
+
+            //rotate every lane forward by eight samples
+            const Simd::float32_8 NextSine{Simd::FusedMultiplyAdd(Sine.Register, StepCosine.Register, (Cosine * StepSine).Register)};
+            Cosine = Simd::float32_8{Simd::FusedMultiplyAdd(Cosine.Register, StepCosine.Register, _mm256_sub_ps(_mm256_setzero_ps(), (Sine * StepSine).Register))};
+            Sine = NextSine;
+        }
+    }
+
+    Audio.Samples.resize(NumSamples);
+
+    return Audio;
+}
+
+FPcmAudio FMorseAudioRenderer::RenderText(const std::string_view PlainText) const
+{
+    return Render(EncodeTextToKeying(PlainText, Settings.Timing));
+}
+
+FPcmAudio EncodePlainTextToAudio(const std::string& PathToFile, const FToneSettings& Settings)
+{
+    return FMorseAudioRenderer{Settings}.Render(EncodePlainTextToKeying(PathToFile, Settings.Timing));
+}
+
+void EncodePlainTextFilesToAudio(const std::vector<std::pair<std::string, std::string>>& InputOutputPaths, const FToneSettings& Settings)
+{
+    const FMorseAudioRenderer Renderer{Settings};
+
+    std::atomic<size_t> NextJob{0};
+
+    auto Worker = [&Renderer, &InputOutputPaths, &NextJob, &Settings]() -> void
+    {
+        for(size_t Job{NextJob++}; Job < InputOutputPaths.size(); Job = NextJob++)
+        {
+            WriteToFile(InputOutputPaths[Job].second, Renderer.Render(EncodePlainTextToKeying(InputOutputPaths[Job].first, Settings.Timing)));
+        }
+    };
+
+    std::vector<std::thread> Workers{};
+
+    for(size_t Thread{0}; Thread < std::max(1u, std::thread::hardware_concurrency()); ++Thread)
+    {
+        Workers.emplace_back(Worker);
+    }
+
+    for(std::thread& Thread : Workers)
+    {
+        Thread.join();
+    }
+}
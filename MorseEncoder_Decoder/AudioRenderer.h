@@ -0,0 +1,54 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "KeyingStream.h"
+#include "WavFile.h"
+#include <utility>
+
+struct FToneSettings
+{
+    uint32 SampleRate{8000};
+    float32 Wpm{20.f};
+    float32 ToneFrequency{600.f};
+    float32 EdgeSeconds{0.005f};
+    float32 Amplitude{0.8f};
+    FKeyingTiming Timing{};
+};
+
+//renders keying as a sine tone, every key-down run is one precomputed raised-cosine envelope times a vectorized oscillator
+class FMorseAudioRenderer final
+{
+public:
+
+    explicit FMorseAudioRenderer(const FToneSettings& InSettings);
+
+    FPcmAudio Render(const FKeyingStream& Stream) const;
+
+    FPcmAudio RenderText(std::string_view PlainText) const;
+
+private:
+
+    std::vector<Simd::float32_8> MakeEnvelope(uint64 NumUnits) const;
+
+    FToneSettings Settings;
+    uint32 UnitSamples;
+
+    std::vector<Simd::float32_8> DotEnvelope;
+    std::vector<Simd::float32_8> DashEnvelope;
+};
+
+FPcmAudio EncodePlainTextToAudio(const std::string& PathToFile, const FToneSettings& Settings = {});
+
+//renders every input file to its output file, spread over all hardware threads
+void EncodePlainTextFilesToAudio(const std::vector<std::pair<std::string, std::string>>& InputOutputPaths, const FToneSettings& Settings = {});
@@ -0,0 +1,177 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "BlinkDecoder.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace Blink
+{
+    //one tile row is exactly one AVX register of pixels
+    constexpr uint32 TileSize{32};
+
+    //frames spread over the whole dump that are used to find the blinking region
+    constexpr size_t NumSampledFrames{1024};
+
+    //tiles with at least this share of the strongest variance belong to the region, so a lamp over a tile border is kept whole
+    constexpr float64 RegionVarianceShare{0.5};
+
+    //frames read per call in the brightness pass
+    constexpr size_t NumFramesPerRead{16};
+
+    //the envelope is timed in frames per thousand seconds, so rates like 29.97 stay exact
+    constexpr size_t RateScale{1000};
+
+    uint64 SumTile(const uint8* Frame, const uint32 Width, const uint32 NumTileColumns, const uint32 Tile)
+    {
+        const uint8* Row{Frame + static_cast<size_t>(Tile / NumTileColumns) * TileSize * Width + (Tile % NumTileColumns) * TileSize};
+
+        __m256i Sums{_mm256_setzero_si256()};
+
+        //sad against zero adds up each group of eight pixels into one 64 bit lane
+        for(uint32 Line{0}; Line < TileSize; ++Line, Row += Width)
+        {
+            Sums = _mm256_add_epi64(Sums, _mm256_sad_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(Row)), _mm256_setzero_si256()));
+        }
+
+        return static_cast<uint64>(_mm256_extract_epi64(Sums, 0) + _mm256_extract_epi64(Sums, 1) + _mm256_extract_epi64(Sums, 2) + _mm256_extract_epi64(Sums, 3));
+    }
+}
+
+std::vector<char> DecodeBlinkFramesToPlainText(const std::string& PathToFile, const FFrameFormat& Format, const float32 InitialWpm)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, std::ios::in | std::ios::binary);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return std::vector<char>{};
+    }
+
+    const uint32 NumTileColumns{Format.Width / Blink::TileSize};
+    const uint32 NumTiles{NumTileColumns * (Format.Height / Blink::TileSize)};
+
+    if(NumTiles == 0)
+    {
+        std::cerr << "Frames have to be at least " << Blink::TileSize << "x" << Blink::TileSize << " pixels" << std::endl;
+        return std::vector<char>{};
+    }
+
+    const size_t FrameBytes{static_cast<size_t>(Format.Width) * Format.Height};
+
+    FStream.seekg(0, std::ios::end);
+    const size_t NumFrames{static_cast<size_t>(FStream.tellg()) / FrameBytes};
+
+    //the region is where brightness changes the most over time, measured on frames spread across the dump
+    std::vector<float64> TileSums(NumTiles, 0.0);
+    std::vector<float64> TileSquareSums(NumTiles, 0.0);
+    std::vector<uint8> Frame(FrameBytes);
+
+    const size_t NumSampled{std::min(NumFrames, Blink::NumSampledFrames)};
+
+    for(size_t Sampled{0}; Sampled < NumSampled; ++Sampled)
+    {
+        FStream.seekg(static_cast<std::streamoff>(Sampled * NumFrames / NumSampled * FrameBytes));
+        FStream.read(reinterpret_cast<char*>(Frame.data()), static_cast<std::streamsize>(FrameBytes));
+
+        for(uint32 Tile{0}; Tile < NumTiles; ++Tile)
+        {
+            const float64 Sum{static_cast<float64>(Blink::SumTile(Frame.data(), Format.Width, NumTileColumns, Tile))};
+
+            TileSums[Tile] += Sum;
+            TileSquareSums[Tile] += Sum * Sum;
+        }
+    }
+
+    FStream.close();
+
+    std::vector<float64> Variances(NumTiles);
+
+    for(uint32 Tile{0}; Tile < NumTiles; ++Tile)
+    {
+        const float64 Mean{TileSums[Tile] / static_cast<float64>(std::max<size_t>(1, NumSampled))};
+        Variances[Tile] = TileSquareSums[Tile] / static_cast<float64>(std::max<size_t>(1, NumSampled)) - Mean * Mean;
+    }
+
+    const float64 MaxVariance{*std::max_element(Variances.begin(), Variances.end())};
+
+    if(MaxVariance <= 0.0)
+    {
+        std::cerr << "No blinking region found in: " << PathToFile << std::endl;
+        return std::vector<char>{};
+    }
+
+    std::vector<uint32> RegionTiles{};
+
+    for(uint32 Tile{0}; Tile < NumTiles; ++Tile)
+    {
+        if(Variances[Tile] >= Blink::RegionVarianceShare * MaxVariance)
+        {
+            RegionTiles.emplace_back(Tile);
+        }
+    }
+
+    //only the region is summed from here on, every worker reads its own contiguous share of the frames
+    std::vector<float32> Brightness(NumFrames);
+    std::vector<std::thread> Workers{};
+
+    const size_t NumWorkers{std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(), NumFrames / 256))};
+
+    for(size_t Worker{0}; Worker < NumWorkers; ++Worker)
+    {
+        Workers.emplace_back([&, First = NumFrames * Worker / NumWorkers, Last = NumFrames * (Worker + 1) / NumWorkers]() -> void
+        {
+            std::fstream WorkerStream{};
+            WorkerStream.open(PathToFile, std::ios::in | std::ios::binary);
+            WorkerStream.seekg(static_cast<std::streamoff>(First * FrameBytes));
+
+            std::vector<uint8> Frames(FrameBytes * Blink::NumFramesPerRead);
+
+            for(size_t FrameIndex{First}; FrameIndex < Last; FrameIndex += Blink::NumFramesPerRead)
+            {
+                const size_t NumToRead{std::min(Blink::NumFramesPerRead, Last - FrameIndex)};
+
+                WorkerStream.read(reinterpret_cast<char*>(Frames.data()), static_cast<std::streamsize>(NumToRead * FrameBytes));
+
+                for(size_t Read{0}; Read < NumToRead; ++Read)
+                {
+                    uint64 Sum{0};
+
+                    for(const uint32 Tile : RegionTiles)
+                    {
+                        Sum += Blink::SumTile(&Frames[Read * FrameBytes], Format.Width, NumTileColumns, Tile);
+                    }
+
+                    Brightness[FrameIndex + Read] = static_cast<float32>(Sum);
+                }
+            }
+        });
+    }
+
+    for(std::thread& Worker : Workers)
+    {
+        Worker.join();
+    }
+
+    //the lamp never gets darker than off, so the darkest frame is the baseline and the timeline looks like a tone envelope
+    const float32 Baseline{Brightness.empty() ? 0.f : *std::min_element(Brightness.begin(), Brightness.end())};
+
+    for(float32& Value : Brightness)
+    {
+        Value -= Baseline;
+    }
+
+    return DecodeEnvelope(Brightness, Blink::RateScale, static_cast<uint32>(std::lround(Format.FramesPerSecond * Blink::RateScale)), InitialWpm);
+}
@@ -0,0 +1,27 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "ToneDecoder.h"
+
+//raw 8 bit grayscale frames stored back to back, without any header
+struct FFrameFormat
+{
+    uint32 Width{0};
+    uint32 Height{0};
+    float32 FramesPerSecond{30.f};
+};
+
+//finds the blinking region of a frame dump by the temporal variance of 32x32 tiles, turns its brightness into an on/off timeline and decodes it.
+//tiles that do not fit completely at the right and bottom edges are ignored
+std::vector<char> DecodeBlinkFramesToPlainText(const std::string& PathToFile, const FFrameFormat& Format, float32 InitialWpm = 0.f);
@@ -11,17 +11,17 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 #include "FileReader.h"
+#include "MorseSink.h"
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <type_traits>
 namespace MorseCodes
 {
-    constexpr int16 Short{'*'};
-    constexpr int16 Long{'-'};
-    constexpr int16 NewWord{'|'};
-    constexpr int16 SeparateChar{'&'};
     const constexpr char Unrecognized{'#'};
 
     constexpr Simd::int16_8 NullChar{0, 0, 0, 0, 0, 0, 0, 0};
     constexpr Simd::int16_8 NewWordChar{NewWord, 0, 0, 0, 0, 0, 0, 0};
-    constexpr Simd::int16_8 SeparateCharacterChar{SeparateChar, 0, 0, 0, 0, 0, 0, 0};
 
     constexpr Simd::int16_8 A{Short, Long, 0, 0, 0, 0, 0, 0};
     constexpr Simd::int16_8 B{Long, Short, Short, Short, 0, 0, 0, 0};
@@ -58,132 +58,68 @@ namespace MorseCodes
     constexpr Simd::int16_8 Five{Short, Short, Short, Short, Short, 0, 0, 0};
     constexpr Simd::int16_8 Six{Long, Short, Short, Short, Short, 0, 0, 0};
     constexpr Simd::int16_8 Seven{Long, Long, Short, Short, Short, 0, 0, 0};
-    constexpr Simd::int16_8 Eight{Long, Long, Long, Long, Short, 0, 0, 0};
-    constexpr Simd::int16_8 Nine{Long, Long, Long, Long, Long, 0, 0, 0};
+    constexpr Simd::int16_8 Eight{Long, Long, Long, Short, Short, 0, 0, 0};
+    constexpr Simd::int16_8 Nine{Long, Long, Long, Long, Short, 0, 0, 0};
 
     constexpr Simd::int16_8 Dot{Short, Long, Short, Long, Short, Long, 0, 0};
     constexpr Simd::int16_8 Comma{Long, Long, Short, Short, Long, Long, 0, 0};
 
-    constexpr Simd::int16_8 OpenBracket{Long, Short, Long, Long, Short, Long, 0, 0};
-    constexpr Simd::int16_8 CloseBracket{Long, Short, Long, Long, Short, 0, 0, 0};
+    constexpr Simd::int16_8 OpenBracket{Long, Short, Long, Long, Short, 0, 0, 0};
+    constexpr Simd::int16_8 CloseBracket{Long, Short, Long, Long, Short, Long, 0, 0};
 
     constexpr Simd::int16_8 QuestionMark{Short, Short, Long, Long, Short, Short, 0, 0};
     constexpr Simd::int16_8 ExclamationMark{Long, Short, Long, Short, Long, Long, 0, 0};
-}
 
-std::vector<char> DecodeMorseToPlainText(const std::string& PathToFile)
-{
-    constexpr auto GetCharacterFromMorse = [](const Simd::int16_8& MorseCode) -> char
+    constexpr Simd::int16_8 Slash{Long, Short, Short, Long, Short, 0, 0, 0};
+    constexpr Simd::int16_8 Equals{Long, Short, Short, Short, Long, 0, 0, 0};
+    constexpr Simd::int16_8 Plus{Short, Long, Short, Long, Short, 0, 0, 0};
+    constexpr Simd::int16_8 Hyphen{Long, Short, Short, Short, Short, Long, 0, 0};
+    constexpr Simd::int16_8 At{Short, Long, Long, Short, Long, Short, 0, 0};
+    constexpr Simd::int16_8 Colon{Long, Long, Long, Short, Short, Short, 0, 0};
+    constexpr Simd::int16_8 Semicolon{Long, Short, Long, Short, Long, Short, 0, 0};
+    constexpr Simd::int16_8 Apostrophe{Short, Long, Long, Long, Long, Short, 0, 0};
+    constexpr Simd::int16_8 Quote{Short, Long, Short, Short, Long, Short, 0, 0};
+    constexpr Simd::int16_8 Dollar{Short, Short, Short, Long, Short, Short, Long, 0};
+    constexpr Simd::int16_8 Underscore{Short, Short, Long, Long, Short, Long, 0, 0};
+    constexpr Simd::int16_8 Ampersand{Short, Long, Short, Short, Short, 0, 0, 0};
+
+    const constexpr std::array<char, 54> Alphabet
     {
-        using namespace MorseCodes;
-
-        if(MorseCode == A) return 'A';
-        else if(MorseCode == B) return 'B';
-        else if(MorseCode == C) return 'C';
-        else if(MorseCode == D) return 'D';
-        else if(MorseCode == E) return 'E';
-        else if(MorseCode == F) return 'F';
-        else if(MorseCode == G) return 'G';
-        else if(MorseCode == H) return 'H';
-        else if(MorseCode == I) return 'I';
-        else if(MorseCode == J) return 'J';
-        else if(MorseCode == K) return 'K';
-        else if(MorseCode == L) return 'L';
-        else if(MorseCode == M) return 'M';
-        else if(MorseCode == N) return 'N';
-        else if(MorseCode == O) return 'O';
-        else if(MorseCode == P) return 'P';
-        else if(MorseCode == Q) return 'Q';
-        else if(MorseCode == R) return 'R';
-        else if(MorseCode == S) return 'S';
-        else if(MorseCode == T) return 'T';
-        else if(MorseCode == U) return 'U';
-        else if(MorseCode == V) return 'V';
-        else if(MorseCode == W) return 'W';
-        else if(MorseCode == X) return 'X';
-        else if(MorseCode == Y) return 'Y';
-        else if(MorseCode == Z) return 'Z';
-        else if(MorseCode == Zero) return '0';
-        else if(MorseCode == One) return '1';
-        else if(MorseCode == Two) return '2';
-        else if(MorseCode == Three) return '3';
-        else if(MorseCode == Four) return '4';
-        else if(MorseCode == Five) return '5';
-        else if(MorseCode == Six) return '6';
-        else if(MorseCode == Seven) return '7';
-        else if(MorseCode == Eight) return '8';
-        else if(MorseCode == Nine) return '9';
-        else if(MorseCode == Dot) return '.';
-        else if(MorseCode == OpenBracket) return '(';
-        else if(MorseCode == CloseBracket) return ')';
-        else if(MorseCode == Comma) return ',';
-        else if(MorseCode == QuestionMark) return '?';
-        else if(MorseCode == ExclamationMark) return '!';
-        else if(MorseCode == NewWordChar) return ' ';
-        else if(MorseCode == NullChar) return '#';
-
-        return '#';
+        'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
+        '.', ',', '(', ')', '?', '!',
+        '/', '=', '+', '-', '@', ':', ';', '\'', '"', '$', '_', '&'
     };
 
-    auto DecodeFile = [&GetCharacterFromMorse, &PathToFile]() -> std::vector<char>
+    const constexpr std::array<FProsign, 11> Prosigns
     {
-        std::fstream FStream{};
-
-        FStream.open(PathToFile, std::ios::in);
-
-        std::vector<char> PlainTextVector{};
-
-        if(!FStream)
-        {
-            std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
-            return PlainTextVector;
-        }
+        FProsign{"SOS", "***---***"},
+        FProsign{"HH", "********"},
+        FProsign{"SK", "***-*-"},
+        FProsign{"KA", "-*-*-"},
+        FProsign{"VE", "***-*"},
+        FProsign{"BK", "-***-*-"},
+        FProsign{"CL", "-*-**-**"},
+        FProsign{"AR", "*-*-*"},
+        FProsign{"BT", "-***-"},
+        FProsign{"KN", "-*--*"},
+        FProsign{"AS", "*-***"}
+    };
 
-        Simd::int16_8 MorseCode{};
+    uint16 PackElements(const std::string_view Elements)
+    {
+        uint16 PackedCode{1};
 
-        for(int8 RegisterIndex{0}; !FStream.eof(); ++RegisterIndex)
+        for(const char Element : Elements)
         {
-            char TempChar;
-
-            FStream >> std::noskipws >> TempChar;
-
-            if unlikely(TempChar == static_cast<char>(MorseCodes::SeparateChar))
-            {
-                PlainTextVector.emplace_back(GetCharacterFromMorse(MorseCode));
-
-                MorseCode = static_cast<int16>(0);
-                RegisterIndex = -1;
-            }
-            else if unlikely(TempChar == static_cast<char>(MorseCodes::NewWord))
-            {
-                PlainTextVector.emplace_back(GetCharacterFromMorse(MorseCode));
-                PlainTextVector.emplace_back(' ');
-
-                MorseCode = static_cast<int16>(0);
-                RegisterIndex = -1;
-            }
-            else
-            {
-                check(RegisterIndex < 8)
-
-                MorseCode.Register[RegisterIndex] = static_cast<int16>(static_cast<uint8>(TempChar));
-            }
+            PackedCode = static_cast<uint16>((PackedCode << 1) | (Element == static_cast<char>(Long)));
         }
 
-        FStream.close();
-
-        return PlainTextVector;
-    };
-
-    return DecodeFile();
-}
+        return PackedCode;
+    }
 
-std::vector<Simd::int16_8> EncodePlainTextToMorse(const std::string& PathToFile)
-{
-    constexpr auto GetMorseFromCharacter = [](char Character) -> Simd::int16_8
+    Simd::int16_8 LookupCharacter(char Character)
     {
-        using namespace MorseCodes;
-
         Character -= 32 * (Character >= 'a' && Character <= 'z');
 
         switch(Character)
@@ -197,7 +133,7 @@ std::vector<Simd::int16_8> EncodePlainTextToMorse(const std::string& PathToFile)
             case 'G': return G;
             case 'H': return H;
             case 'I': return I;
-            case 'j': return J;
+            case 'J': return J;
             case 'K': return K;
             case 'L': return L;
             case 'M': return M;
@@ -230,48 +166,385 @@ std::vector<Simd::int16_8> EncodePlainTextToMorse(const std::string& PathToFile)
             case ',': return Comma;
             case '?': return QuestionMark;
             case '!': return ExclamationMark;
+            case '/': return Slash;
+            case '=': return Equals;
+            case '+': return Plus;
+            case '-': return Hyphen;
+            case '@': return At;
+            case ':': return Colon;
+            case ';': return Semicolon;
+            case '\'': return Apostrophe;
+            case '"': return Quote;
+            case '$': return Dollar;
+            case '_': return Underscore;
+            case '&': return Ampersand;
             case ' ': return NewWordChar;
 
             default: return NullChar;
         }
-    };
+    }
+}
 
-    std::fstream FStream{};
+uint16 PackMorseCode(const Simd::int16_8& MorseCode)
+{
+    uint16 PackedCode{1};
 
-    FStream.open(PathToFile, std::ios::in);
+    for(size_t Index{0}; Index < Simd::int16_8::GetNumElements() && MorseCode[Index] != 0; ++Index)
+    {
+        if unlikely(MorseCode[Index] != MorseCodes::Short && MorseCode[Index] != MorseCodes::Long)
+        {
+            return 0;
+        }
 
-    std::vector<Simd::int16_8> MorseCodeVector{};
+        PackedCode = static_cast<uint16>((PackedCode << 1) | (MorseCode[Index] == MorseCodes::Long));
+    }
 
-    if(!FStream)
+    return PackedCode;
+}
+
+char GetCharacterFromMorse(const Simd::int16_8& MorseCode)
+{
+    if(MorseCode == MorseCodes::NewWordChar)
     {
-        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
-        return MorseCodeVector;
+        return ' ';
     }
 
-    while(!FStream.eof())
+    //invalid elements pack to 0, which decodes as Unrecognized like the empty code
+    return GetCharacterFromPackedMorse(PackMorseCode(MorseCode));
+}
+
+Simd::int16_8 GetMorseFromCharacter(const char Character)
+{
+    static const std::array<Simd::int16_8, 256> EncodeTable{[]() -> std::array<Simd::int16_8, 256>
+    {
+        //the register's zeroing constructor is explicit, so the table is default-initialized and every entry assigned below
+        std::array<Simd::int16_8, 256> Table;
+
+        for(size_t Index{0}; Index < Table.size(); ++Index)
+        {
+            Table[Index] = MorseCodes::LookupCharacter(static_cast<char>(Index));
+        }
+
+        return Table;
+    }()};
+
+    return EncodeTable[static_cast<uint8>(Character)];
+}
+
+char GetCharacterFromPackedMorse(const uint16 PackedCode)
+{
+    static const std::array<char, 2 << MorseCodes::MaxPackedElements> DecodeTable{[]() -> std::array<char, 2 << MorseCodes::MaxPackedElements>
+    {
+        std::array<char, 2 << MorseCodes::MaxPackedElements> Table{};
+        Table.fill(MorseCodes::Unrecognized);
+
+        for(const char Character : MorseCodes::Alphabet)
+        {
+            Table[PackMorseCode(GetMorseFromCharacter(Character))] = Character;
+        }
+
+        return Table;
+    }()};
+
+    return DecodeTable[PackedCode];
+}
+
+std::string_view GetTextFromPackedMorse(const uint16 PackedCode)
+{
+    constexpr size_t NumTexts{1 + MorseCodes::Alphabet.size() + MorseCodes::Prosigns.size()};
+
+    static const std::array<std::string, NumTexts> Texts{[]() -> std::array<std::string, NumTexts>
     {
-        char TempChar;
+        std::array<std::string, NumTexts> Strings{};
+        Strings[0] = std::string{MorseCodes::Unrecognized};
 
-        FStream >> std::noskipws >> TempChar;
+        for(size_t Index{0}; Index < MorseCodes::Alphabet.size(); ++Index)
+        {
+            Strings[1 + Index] = std::string{MorseCodes::Alphabet[Index]};
+        }
 
-        if unlikely(MorseCodeVector.emplace_back(GetMorseFromCharacter(TempChar)) == MorseCodes::NewWordChar)
+        for(size_t Index{0}; Index < MorseCodes::Prosigns.size(); ++Index)
         {
-            MorseCodeVector.erase(MorseCodeVector.cend() - 2);
+            Strings[1 + MorseCodes::Alphabet.size() + Index] = "<" + std::string{MorseCodes::Prosigns[Index].Name} + ">";
         }
-        else
+
+        return Strings;
+    }()};
+
+    //index into Texts for every packed code, characters are filled in last so they win over prosigns sharing their code
+    static const std::array<uint8, 2 << MorseCodes::MaxPackedElements> TextTable{[]() -> std::array<uint8, 2 << MorseCodes::MaxPackedElements>
+    {
+        std::array<uint8, 2 << MorseCodes::MaxPackedElements> Table{};
+
+        for(size_t Index{0}; Index < MorseCodes::Prosigns.size(); ++Index)
         {
-            MorseCodeVector.emplace_back(MorseCodes::SeparateCharacterChar);
+            Table[MorseCodes::PackElements(MorseCodes::Prosigns[Index].Elements)] = static_cast<uint8>(1 + MorseCodes::Alphabet.size() + Index);
+        }
+
+        for(size_t Index{0}; Index < MorseCodes::Alphabet.size(); ++Index)
+        {
+            Table[PackMorseCode(GetMorseFromCharacter(MorseCodes::Alphabet[Index]))] = static_cast<uint8>(1 + Index);
+        }
+
+        return Table;
+    }()};
+
+    return Texts[TextTable[PackedCode]];
+}
+
+uint16 GetPackedMorseFromProsign(const std::string_view Name)
+{
+    for(const MorseCodes::FProsign& Prosign : MorseCodes::Prosigns)
+    {
+        if(Prosign.Name == Name)
+        {
+            return MorseCodes::PackElements(Prosign.Elements);
         }
     }
 
-    MorseCodeVector.erase(MorseCodeVector.end());
-    MorseCodeVector.erase(MorseCodeVector.end());
+    return 0;
+}
 
-    FStream.close();
+uint16 GetPackedMorseFromProsignText(const std::string_view Text, size_t& OutNumBytes)
+{
+    OutNumBytes = 0;
+
+    const size_t NameEnd{Text.find('>', 1)};
+
+    if(Text.empty() || Text.front() != '<' || NameEnd == std::string_view::npos || NameEnd >= MorseCodes::MaxProsignTextBytes)
+    {
+        return 0;
+    }
+
+    std::string Name{Text.substr(1, NameEnd - 1)};
+
+    for(char& Character : Name)
+    {
+        Character -= 32 * (Character >= 'a' && Character <= 'z');
+    }
+
+    const uint16 PackedCode{GetPackedMorseFromProsign(Name)};
+
+    OutNumBytes = PackedCode != 0 ? NameEnd + 1 : 0;
+
+    return PackedCode;
+}
+
+char RepairCharacterFromMorse(const Simd::int16_8& MorseCode)
+{
+    return RepairCharacterFromPackedMorse(PackMorseCode(MorseCode));
+}
+
+char RepairCharacterFromPackedMorse(const uint16 PackedCode)
+{
+    constexpr size_t NumElements{MorseCodes::MaxSymbolElements};
+
+    //every pattern up to the longest symbol, mapped to the symbol with the smallest edit distance over the packed elements
+    static const std::array<char, 2 << NumElements> CorrectionTable{[]() -> std::array<char, 2 << NumElements>
+    {
+        auto GetEditDistance = [](const uint16 LHS, const uint16 RHS) -> uint32
+        {
+            const uint32 LHSLength{static_cast<uint32>(std::bit_width(LHS) - 1)};
+            const uint32 RHSLength{static_cast<uint32>(std::bit_width(RHS) - 1)};
+
+            std::array<uint32, NumElements + 1> Previous{};
+            std::array<uint32, NumElements + 1> Current{};
+
+            for(uint32 Column{0}; Column <= RHSLength; ++Column)
+            {
+                Previous[Column] = Column;
+            }
+
+            for(uint32 Row{1}; Row <= LHSLength; ++Row)
+            {
+                Current[0] = Row;
+
+                for(uint32 Column{1}; Column <= RHSLength; ++Column)
+                {
+                    const bool bSameElement{((LHS >> (LHSLength - Row)) & 1) == ((RHS >> (RHSLength - Column)) & 1)};
+
+                    Current[Column] = std::min({Previous[Column] + 1, Current[Column - 1] + 1, Previous[Column - 1] + !bSameElement});
+                }
+
+                std::swap(Previous, Current);
+            }
+
+            return Previous[RHSLength];
+        };
+
+        std::array<char, 2 << NumElements> Table{};
+        Table.fill(MorseCodes::Unrecognized);
+
+        for(uint16 Pattern{2}; Pattern < Table.size(); ++Pattern)
+        {
+            uint32 BestDistance{std::numeric_limits<uint32>::max()};
+
+            for(const char Character : MorseCodes::Alphabet)
+            {
+                const uint32 Distance{GetEditDistance(Pattern, PackMorseCode(GetMorseFromCharacter(Character)))};
+
+                if(Distance < BestDistance)
+                {
+                    BestDistance = Distance;
+                    Table[Pattern] = Character;
+                }
+            }
+        }
+
+        return Table;
+    }()};
+
+    return PackedCode < CorrectionTable.size() ? CorrectionTable[PackedCode] : MorseCodes::Unrecognized;
+}
+
+size_t GetRemainingBytes(std::istream& Stream)
+{
+    const std::streampos Start{Stream.tellg()};
+
+    if(Start == std::streampos{-1})
+    {
+        Stream.clear();
+        return 0;
+    }
+
+    Stream.seekg(0, std::ios::end);
+    const std::streampos End{Stream.tellg()};
+
+    Stream.clear();
+    Stream.seekg(Start);
+
+    return End > Start ? static_cast<size_t>(End - Start) : 0;
+}
+
+size_t StripIgnorableBytes(char* Text, const size_t NumBytes)
+{
+    //pshufb indices that move the bytes of an 8 byte group whose mask bit is set to the front
+    static const std::array<std::array<uint8, 8>, 256> LeftPackTable{[]() -> std::array<std::array<uint8, 8>, 256>
+    {
+        std::array<std::array<uint8, 8>, 256> Table{};
+
+        for(uint32 Mask{0}; Mask < Table.size(); ++Mask)
+        {
+            uint8 NumKept{0};
+
+            for(uint8 Byte{0}; Byte < 8; ++Byte)
+            {
+                if((Mask >> Byte) & 1)
+                {
+                    Table[Mask][NumKept++] = Byte;
+                }
+            }
+        }
+
+        return Table;
+    }()};
+
+    auto IsIgnorable = [](const char Character) -> bool
+    {
+        return Character == ' ' || Character == '\t' || Character == '\r' || Character == '\n';
+    };
+
+    size_t NumKept{0};
+    size_t Position{0};
+
+    for(; Position + 32 <= NumBytes; Position += 32)
+    {
+        const __m256i Bytes{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(Text + Position))};
+
+        const __m256i Blanks{_mm256_or_si256(_mm256_cmpeq_epi8(Bytes, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(Bytes, _mm256_set1_epi8('\t')))};
+        const __m256i LineBreaks{_mm256_or_si256(_mm256_cmpeq_epi8(Bytes, _mm256_set1_epi8('\r')), _mm256_cmpeq_epi8(Bytes, _mm256_set1_epi8('\n')))};
+
+        const uint32 Keep{~static_cast<uint32>(_mm256_movemask_epi8(_mm256_or_si256(Blanks, LineBreaks)))};
+
+        //the output never overtakes the input, so every group is loaded before anything is written over it
+        if likely(Keep == ~0u)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(Text + NumKept), Bytes);
+            NumKept += 32;
+            continue;
+        }
+
+        for(size_t Group{0}; Group < 4; ++Group)
+        {
+            const uint32 GroupKeep{(Keep >> (Group * 8)) & 0xFF};
+
+            const __m128i GroupBytes{_mm_loadl_epi64(reinterpret_cast<const __m128i*>(Text + Position + Group * 8))};
+            const __m128i Indices{_mm_loadl_epi64(reinterpret_cast<const __m128i*>(LeftPackTable[GroupKeep].data()))};
+
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(Text + NumKept), _mm_shuffle_epi8(GroupBytes, Indices));
+            NumKept += static_cast<size_t>(std::popcount(GroupKeep));
+        }
+    }
+
+    for(; Position < NumBytes; ++Position)
+    {
+        if(!IsIgnorable(Text[Position]))
+        {
+            Text[NumKept++] = Text[Position];
+        }
+    }
+
+    return NumKept;
+}
+
+std::vector<char> DecodeMorseToPlainText(const std::string& PathToFile, const bool bRepairUnrecognized)
+{
+    std::vector<char> PlainTextVector{};
+    TContainerSink<std::vector<char>> Sink{PlainTextVector};
+    Morse::FDecodeCoder Coder{bRepairUnrecognized};
+
+    Sinks::CodeFile(PathToFile, Coder, Sink);
+
+    return PlainTextVector;
+}
+
+std::pmr::vector<char> DecodeMorseToPlainText(const std::string& PathToFile, std::pmr::memory_resource* Resource, const bool bRepairUnrecognized)
+{
+    std::pmr::vector<char> PlainTextVector(Resource);
+    TContainerSink<std::pmr::vector<char>> Sink{PlainTextVector};
+    Morse::FDecodeCoder Coder{bRepairUnrecognized};
+
+    Sinks::CodeFile(PathToFile, Coder, Sink, Resource);
+
+    return PlainTextVector;
+}
+
+bool DecodeMorseToStream(const std::string& PathToFile, std::ostream& OutStream, const bool bRepairUnrecognized)
+{
+    FStreamSink Sink{OutStream};
+
+    return DecodeMorseToSink(PathToFile, Sink, bRepairUnrecognized);
+}
+
+std::vector<Simd::int16_8> EncodePlainTextToMorse(const std::string& PathToFile)
+{
+    std::vector<Simd::int16_8> MorseCodeVector{};
+    TRegisterSink<std::vector<Simd::int16_8>> Sink{MorseCodeVector};
+    Morse::FEncodeCoder Coder{};
+
+    Sinks::CodeFile(PathToFile, Coder, Sink);
 
     return MorseCodeVector;
 }
 
+std::pmr::vector<Simd::int16_8> EncodePlainTextToMorse(const std::string& PathToFile, std::pmr::memory_resource* Resource)
+{
+    std::pmr::vector<Simd::int16_8> MorseCodeVector(Resource);
+    TRegisterSink<std::pmr::vector<Simd::int16_8>> Sink{MorseCodeVector};
+    Morse::FEncodeCoder Coder{};
+
+    Sinks::CodeFile(PathToFile, Coder, Sink, Resource);
+
+    return MorseCodeVector;
+}
+
+bool EncodePlainTextToStream(const std::string& PathToFile, std::ostream& OutStream)
+{
+    FStreamSink Sink{OutStream};
+
+    return EncodePlainTextToSink(PathToFile, Sink);
+}
+
 void WriteToFile(const std::string& PathToOutFile, const std::vector<char>& StringToWrite)
 {
     std::fstream FStream{};
@@ -284,13 +557,8 @@ void WriteToFile(const std::string& PathToOutFile, const std::vector<char>& Stri
         return;
     }
 
-    for(const char Character : StringToWrite)
-    {
-        if(Character != MorseCodes::Unrecognized)
-        {
-            FStream << Character;
-        }
-    }
+    FStreamSink Sink{FStream};
+    WritePlainText(StringToWrite.data(), StringToWrite.size(), Sink);
 
     FStream.close();
 }
@@ -307,10 +575,8 @@ void WriteToFile(const std::string& PathToOutFile, const std::vector<Simd::int16
         return;
     }
 
-    ForEachValidElementInRegisters(StringToWrite, [&FStream](const int16 Character) -> void
-    {
-        FStream << static_cast<char>(Character);
-    });
+    FStreamSink Sink{FStream};
+    WriteValidElements(StringToWrite, Sink);
 
     FStream.close();
 }
@@ -12,37 +12,126 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <tiff.h>
 #include <fstream>
 #include <string>
+#include <array>
+#include <string_view>
+#include <memory_resource>
+#include <bit>
 #include "Simd_Library-main/SimdRegisterLibrary.h"
-std::vector<char> DecodeMorseToPlainText(const std::string& PathToFile);
+std::vector<char> DecodeMorseToPlainText(const std::string& PathToFile, bool bRepairUnrecognized = false);
+
+//same as above, the result and the read and output buffers are allocated from Resource, so a request can hand everything back with one arena reset.
+//when the file can seek the result is reserved from its size first
+std::pmr::vector<char> DecodeMorseToPlainText(const std::string& PathToFile, std::pmr::memory_resource* Resource, bool bRepairUnrecognized = false);
 
 std::vector<Simd::int16_8> EncodePlainTextToMorse(const std::string& PathToFile);
 
+//same as above, allocated and reserved like the decoder's
+std::pmr::vector<Simd::int16_8> EncodePlainTextToMorse(const std::string& PathToFile, std::pmr::memory_resource* Resource);
+
+//what WriteToFile writes of DecodeMorseToPlainText and EncodePlainTextToMorse, written to OutStream as the file is read so the whole text is never held in memory.
+//false if the file does not open
+bool DecodeMorseToStream(const std::string& PathToFile, std::ostream& OutStream, bool bRepairUnrecognized = false);
+bool EncodePlainTextToStream(const std::string& PathToFile, std::ostream& OutStream);
+
+//the bytes left in a stream opened for reading, 0 when it cannot seek like a pipe or FIFO. the stream stays where it was and usable
+size_t GetRemainingBytes(std::istream& Stream);
+
+//removes spaces, tabs and line breaks in place by left-packing 32 bytes at a time with byte shuffles, returns the number of bytes kept
+size_t StripIgnorableBytes(char* Text, size_t NumBytes);
+
 void WriteToFile(const std::string& PathToOutFile, const std::vector<char>& StringToWrite);
 
 void WriteToFile(const std::string& PathToOutFile, const std::vector<Simd::int16_8>& StringToWrite);
 
 namespace MorseCodes
 {
+    constexpr int16 Short{'*'};
+    constexpr int16 Long{'-'};
+    constexpr int16 NewWord{'|'};
+    constexpr int16 SeparateChar{'&'};
+
     extern const char Unrecognized;
+
+    //every character with a morse representation, in the order used for symbol indices
+    extern const std::array<char, 54> Alphabet;
+
+    //a procedural signal sent as one character, written as <Name> in plain text
+    struct FProsign
+    {
+        std::string_view Name;
+        std::string_view Elements;
+    };
+
+    //AR, BT, KN and AS share their code with + = ( & and decode as those characters, the others decode as <Name>
+    extern const std::array<FProsign, 11> Prosigns;
+
+    //packed codes keep up to this many elements, tables indexed by them have 2 << MaxPackedElements entries
+    constexpr uint32 MaxPackedElements{15};
+
+    //elements of the longest symbol, <SOS>
+    constexpr uint32 MaxSymbolElements{9};
+
+    //names are at most three characters, so five bytes of text always tell whether they hold a prosign
+    constexpr size_t MaxProsignTextBytes{5};
+}
+
+char GetCharacterFromMorse(const Simd::int16_8& MorseCode);
+
+Simd::int16_8 GetMorseFromCharacter(char Character);
+
+//same symbols as GetCharacterFromMorse for a code already packed with PackMorseCode, prosigns without a character are Unrecognized
+char GetCharacterFromPackedMorse(uint16 PackedCode);
+
+//the character as text, or <Name> for a prosign, one table lookup for codes of any length
+std::string_view GetTextFromPackedMorse(uint16 PackedCode);
+
+//packed code of a prosign name like SK or AR, 0 if there is none
+uint16 GetPackedMorseFromProsign(std::string_view Name);
+
+//packed code of a prosign written as <Name> at the start of Text, the name in any case, 0 if Text does not start with one.
+//OutNumBytes is the length of the prosign in Text
+uint16 GetPackedMorseFromProsignText(std::string_view Text, size_t& OutNumBytes);
+
+//like GetCharacterFromMorse, but unknown patterns become the nearest valid symbol by edit distance instead of Unrecognized
+char RepairCharacterFromMorse(const Simd::int16_8& MorseCode);
+
+//same as RepairCharacterFromMorse for a packed code, patterns longer than the longest symbol stay Unrecognized
+char RepairCharacterFromPackedMorse(uint16 PackedCode);
+
+//shifts one byte of morse-code into a code packed like PackMorseCode, anything past MaxPackedElements or a byte that is no element saturates to 0xFFFF,
+//which every table decodes as Unrecognized
+constexpr uint32 AddElementToPackedMorse(const uint32 PackedCode, const char Symbol)
+{
+    return Symbol == static_cast<char>(MorseCodes::Short) || Symbol == static_cast<char>(MorseCodes::Long) ? std::min<uint32>((PackedCode << 1) | (Symbol == static_cast<char>(MorseCodes::Long)), 0xFFFF) : 0xFFFF;
 }
 
-template<typename RegisterType, typename Callback>
-void ForEachValidElementInRegisters(const std::vector<RegisterType>& VectorRegisters, Callback CallbackFunction)
+//the elements of a packed code as registers, a code longer than a register continues in the next one and the writers print lanes back to back.
+//MorseCodeVectorType is anything registers can be emplaced at the back of
+template<typename MorseCodeVectorType>
+void AppendPackedMorseCode(const uint16 PackedCode, MorseCodeVectorType& MorseCodeVector)
 {
-    for(const RegisterType& Register : VectorRegisters)
+    const uint32 NumElements{static_cast<uint32>(std::bit_width(PackedCode) - 1)};
+
+    Simd::int16_8 MorseCode{};
+
+    for(uint32 Element{0}; Element < NumElements; ++Element)
     {
-        for(size_t Index{0}; Index < RegisterType::GetNumElements(); ++Index)
+        MorseCode.Register[Element % Simd::int16_8::GetNumElements()] = ((PackedCode >> (NumElements - 1 - Element)) & 1) ? MorseCodes::Long : MorseCodes::Short;
+
+        if(Element % Simd::int16_8::GetNumElements() == Simd::int16_8::GetNumElements() - 1 || Element == NumElements - 1)
         {
-            if(Register[Index] != 0 && static_cast<char>(Register[Index]) != MorseCodes::Unrecognized)
-            {
-                CallbackFunction(Register[Index]);
-            }
+            MorseCodeVector.emplace_back(MorseCode);
+            MorseCode = static_cast<int16>(0);
         }
     }
 }
 
+//packs the elements of a morse code as bits (short = 0, long = 1) below a leading sentinel bit, returns 0 for invalid elements
+uint16 PackMorseCode(const Simd::int16_8& MorseCode);
+
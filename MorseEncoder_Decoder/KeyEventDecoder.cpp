@@ -0,0 +1,201 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "KeyEventDecoder.h"
+#include <algorithm>
+
+namespace KeyEvents
+{
+    //how far a centroid moves towards each new duration
+    constexpr float32 LearningRate{0.15f};
+
+    constexpr float32 MicrosecondsPerDotAtOneWpm{1200000.f};
+
+    constexpr uint64 KeyDownBit{static_cast<uint64>(1) << 63};
+
+    void MoveCentroid(float32& Centroid, const float32 Duration)
+    {
+        Centroid += LearningRate * (Duration - Centroid);
+    }
+}
+
+FAdaptiveKeyDecoder::FAdaptiveKeyDecoder(const float32 InitialWpm)
+    : DotCentroid(KeyEvents::MicrosecondsPerDotAtOneWpm / InitialWpm)
+    , DashCentroid(3.f * DotCentroid)
+    , ElementGapCentroid(DotCentroid)
+    , CharacterGapCentroid(3.f * DotCentroid)
+{
+}
+
+FKeyDecoderOutput FAdaptiveKeyDecoder::OnKeyEvent(const uint64 TimestampMicroseconds, const bool bKeyDown)
+{
+    FKeyDecoderOutput Output{};
+
+    if(bHasTransition && bKeyDown == bKeyIsDown)
+    {
+        return Output;
+    }
+
+    const float32 Duration{static_cast<float32>(TimestampMicroseconds - LastTransition)};
+
+    //the first event only starts the clock
+    if(bHasTransition && bKeyDown)
+    {
+        Output = Update(TimestampMicroseconds);
+
+        if(Duration < 0.5f * (ElementGapCentroid + CharacterGapCentroid))
+        {
+            KeyEvents::MoveCentroid(ElementGapCentroid, Duration);
+        }
+        else if(Duration < CharacterGapCentroid * 5.f / 3.f)
+        {
+            KeyEvents::MoveCentroid(CharacterGapCentroid, Duration);
+        }
+    }
+    else if(bHasTransition)
+    {
+        const bool bDash{Duration > 0.5f * (DotCentroid + DashCentroid)};
+
+        KeyEvents::MoveCentroid(bDash ? DashCentroid : DotCentroid, Duration);
+
+        //a dash is never allowed to drift below twice a dot, otherwise a run of one kind would pull both centroids together
+        DashCentroid = std::max(DashCentroid, 2.f * DotCentroid);
+        ElementGapCentroid = std::clamp(ElementGapCentroid, 0.5f * DotCentroid, 2.f * DotCentroid);
+        CharacterGapCentroid = std::max(CharacterGapCentroid, 2.f * ElementGapCentroid);
+
+        PackedCode = static_cast<uint16>(std::min<uint32>((PackedCode << 1) | bDash, 0xFFFF));
+    }
+
+    LastTransition = TimestampMicroseconds;
+    bKeyIsDown = bKeyDown;
+    bHasTransition = true;
+
+    return Output;
+}
+
+FKeyDecoderOutput FAdaptiveKeyDecoder::Update(const uint64 TimestampMicroseconds)
+{
+    FKeyDecoderOutput Output{};
+
+    if(!bHasTransition || bKeyIsDown || TimestampMicroseconds < LastTransition)
+    {
+        return Output;
+    }
+
+    const float32 Gap{static_cast<float32>(TimestampMicroseconds - LastTransition)};
+
+    if(Gap >= 0.5f * (ElementGapCentroid + CharacterGapCentroid))
+    {
+        EmitCharacter(Output);
+    }
+
+    if(Gap >= CharacterGapCentroid * 5.f / 3.f)
+    {
+        EmitWordBreak(Output);
+    }
+
+    return Output;
+}
+
+FKeyDecoderOutput FAdaptiveKeyDecoder::Flush()
+{
+    FKeyDecoderOutput Output{};
+
+    EmitCharacter(Output);
+    bWordBreakPending = false;
+
+    return Output;
+}
+
+float32 FAdaptiveKeyDecoder::GetWordsPerMinute() const
+{
+    return KeyEvents::MicrosecondsPerDotAtOneWpm / (0.5f * (DotCentroid + DashCentroid / 3.f));
+}
+
+uint64 FAdaptiveKeyDecoder::GetCharacterGapThreshold() const
+{
+    return static_cast<uint64>(0.5f * (ElementGapCentroid + CharacterGapCentroid));
+}
+
+void FAdaptiveKeyDecoder::EmitCharacter(FKeyDecoderOutput& Output)
+{
+    if(PackedCode != 1)
+    {
+        Output.Characters[Output.NumCharacters++] = GetCharacterFromPackedMorse(PackedCode);
+        PackedCode = 1;
+        bWordBreakPending = true;
+    }
+}
+
+void FAdaptiveKeyDecoder::EmitWordBreak(FKeyDecoderOutput& Output)
+{
+    if(bWordBreakPending)
+    {
+        Output.Characters[Output.NumCharacters++] = ' ';
+        bWordBreakPending = false;
+    }
+}
+
+bool ReadKeyEvent(std::istream& Stream, const EKeyEventFormat Format, FKeyEvent& OutEvent)
+{
+    if(Format == EKeyEventFormat::Binary)
+    {
+        uint64 Record;
+
+        if(!Stream.read(reinterpret_cast<char*>(&Record), sizeof(Record)))
+        {
+            return false;
+        }
+
+        OutEvent.TimestampMicroseconds = Record & ~KeyEvents::KeyDownBit;
+        OutEvent.bKeyDown = (Record & KeyEvents::KeyDownBit) != 0;
+
+        return true;
+    }
+
+    uint32 State;
+
+    if(!(Stream >> OutEvent.TimestampMicroseconds >> State))
+    {
+        return false;
+    }
+
+    OutEvent.bKeyDown = State != 0;
+
+    return true;
+}
+
+std::vector<char> DecodeKeyEventsToPlainText(const std::string& PathToFile, const EKeyEventFormat Format)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, Format == EKeyEventFormat::Binary ? std::ios::in | std::ios::binary : std::ios::in);
+
+    std::vector<char> PlainTextVector{};
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return PlainTextVector;
+    }
+
+    FAdaptiveKeyDecoder Decoder{};
+
+    ForEachDecodedKeyEventCharacter(FStream, Format, Decoder, [&PlainTextVector](const char Character) -> void
+    {
+        PlainTextVector.emplace_back(Character);
+    });
+
+    FStream.close();
+
+    return PlainTextVector;
+}
@@ -0,0 +1,97 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "FileReader.h"
+
+//at most a character and the word space after it come out of a single event
+struct FKeyDecoderOutput
+{
+    std::array<char, 2> Characters{};
+    uint8 NumCharacters{0};
+
+    const char* begin() const {return Characters.data();}
+    const char* end() const {return Characters.data() + NumCharacters;}
+};
+
+//decodes key-down/key-up transitions at drifting speed, durations are classified against running centroids that follow the operator
+class FAdaptiveKeyDecoder final
+{
+public:
+
+    explicit FAdaptiveKeyDecoder(float32 InitialWpm = 20.f);
+
+    FKeyDecoderOutput OnKeyEvent(uint64 TimestampMicroseconds, bool bKeyDown);
+
+    //emits a character as soon as the gap after it is long enough, without waiting for the next key-down
+    FKeyDecoderOutput Update(uint64 TimestampMicroseconds);
+
+    FKeyDecoderOutput Flush();
+
+    float32 GetWordsPerMinute() const;
+
+    //how long the key has to stay up before Update emits the pending character
+    uint64 GetCharacterGapThreshold() const;
+
+private:
+
+    void EmitCharacter(FKeyDecoderOutput& Output);
+
+    void EmitWordBreak(FKeyDecoderOutput& Output);
+
+    float32 DotCentroid;
+    float32 DashCentroid;
+    float32 ElementGapCentroid;
+    float32 CharacterGapCentroid;
+
+    uint64 LastTransition{0};
+    uint16 PackedCode{1};
+    bool bKeyIsDown{false};
+    bool bHasTransition{false};
+    bool bWordBreakPending{false};
+};
+
+struct FKeyEvent
+{
+    uint64 TimestampMicroseconds;
+    bool bKeyDown;
+};
+
+enum class EKeyEventFormat : uint8
+{
+    Text,   //one "<microseconds> <1 = down, 0 = up>" pair per line
+    Binary  //little-endian uint64 per event, bit 63 = key down, the rest is the timestamp in microseconds
+};
+
+bool ReadKeyEvent(std::istream& Stream, EKeyEventFormat Format, FKeyEvent& OutEvent);
+
+std::vector<char> DecodeKeyEventsToPlainText(const std::string& PathToFile, EKeyEventFormat Format);
+
+template<typename Callback>
+void ForEachDecodedKeyEventCharacter(std::istream& Stream, const EKeyEventFormat Format, FAdaptiveKeyDecoder& Decoder, Callback CallbackFunction)
+{
+    FKeyEvent Event{};
+
+    while(ReadKeyEvent(Stream, Format, Event))
+    {
+        for(const char Character : Decoder.OnKeyEvent(Event.TimestampMicroseconds, Event.bKeyDown))
+        {
+            CallbackFunction(Character);
+        }
+    }
+
+    for(const char Character : Decoder.Flush())
+    {
+        CallbackFunction(Character);
+    }
+}
@@ -0,0 +1,279 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "KeyingStream.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iterator>
+
+namespace Keying
+{
+    struct FCharacterPattern
+    {
+        uint32 Bits;
+        uint8 NumUnits;
+    };
+
+    constexpr uint8 MaxPatternUnits{8 * 3 + 7};
+
+    //on/off units of every byte's morse code without the trailing gap, empty for bytes without one
+    const std::array<FCharacterPattern, 256>& GetCharacterPatterns()
+    {
+        static const std::array<FCharacterPattern, 256> CharacterPatterns{[]() -> std::array<FCharacterPattern, 256>
+        {
+            std::array<FCharacterPattern, 256> Patterns{};
+
+            for(size_t Character{0}; Character < Patterns.size(); ++Character)
+            {
+                const Simd::int16_8 MorseCode{GetMorseFromCharacter(static_cast<char>(Character))};
+
+                if(MorseCode[0] != MorseCodes::Short && MorseCode[0] != MorseCodes::Long)
+                {
+                    continue;
+                }
+
+                FCharacterPattern& Pattern{Patterns[Character]};
+
+                for(size_t Index{0}; Index < Simd::int16_8::GetNumElements() && MorseCode[Index] != 0; ++Index)
+                {
+                    if(Index != 0)
+                    {
+                        ++Pattern.NumUnits;
+                    }
+
+                    const uint8 ElementUnits{static_cast<uint8>(MorseCode[Index] == MorseCodes::Long ? 3 : 1)};
+
+                    Pattern.Bits |= ((1u << ElementUnits) - 1) << Pattern.NumUnits;
+                    Pattern.NumUnits += ElementUnits;
+                }
+            }
+
+            return Patterns;
+        }()};
+
+        return CharacterPatterns;
+    }
+}
+
+FKeyingTiming FKeyingTiming::Farnsworth(const float32 CharacterWpm, const float32 EffectiveWpm)
+{
+    if(EffectiveWpm <= 0.f || EffectiveWpm >= CharacterWpm)
+    {
+        return FKeyingTiming{};
+    }
+
+    //a standard word is 50 units, 31 of them keyed at character speed and 19 spread over its gaps
+    const float32 UnitSeconds{1.2f / CharacterWpm};
+    const float32 TotalGapSeconds{(60.f * CharacterWpm - 37.2f * EffectiveWpm) / (CharacterWpm * EffectiveWpm)};
+
+    FKeyingTiming Timing{};
+    Timing.CharacterGapUnits = std::max(3u, static_cast<uint32>(std::lround(3.f * TotalGapSeconds / 19.f / UnitSeconds)));
+    Timing.WordGapUnits = std::max(7u, static_cast<uint32>(std::lround(7.f * TotalGapSeconds / 19.f / UnitSeconds)));
+
+    return Timing;
+}
+
+FKeyingStream EncodePlainTextToKeying(const std::string& PathToFile, const FKeyingTiming& Timing)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, std::ios::in);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return FKeyingStream{};
+    }
+
+    const std::string PlainText{std::istreambuf_iterator<char>{FStream}, std::istreambuf_iterator<char>{}};
+
+    FStream.close();
+
+    return EncodeTextToKeying(PlainText, Timing);
+}
+
+FKeyingStream EncodeTextToKeying(const std::string_view PlainText, const FKeyingTiming& Timing)
+{
+    const std::array<Keying::FCharacterPattern, 256>& CharacterPatterns{Keying::GetCharacterPatterns()};
+
+    FKeyingStream Stream{};
+
+    //every byte can add at most one pattern and one gap, so the stream is sized once and never reallocates
+    const uint64 MaxUnits{PlainText.size() * (Keying::MaxPatternUnits + std::max(Timing.CharacterGapUnits, Timing.WordGapUnits))};
+    Stream.Words.resize(MaxUnits / 64 + 2, 0);
+
+    uint64* Words{Stream.Words.data()};
+    uint64 Position{0};
+    uint64 PendingGap{0};
+
+    for(const char Character : PlainText)
+    {
+        const Keying::FCharacterPattern Pattern{CharacterPatterns[static_cast<uint8>(Character)]};
+
+        if unlikely(Pattern.NumUnits == 0)
+        {
+            if(Character == ' ' && Position != 0)
+            {
+                PendingGap = Timing.WordGapUnits;
+            }
+            continue;
+        }
+
+        Position += PendingGap;
+        PendingGap = Timing.CharacterGapUnits;
+
+        const uint64 WordIndex{Position >> 6};
+        const uint64 BitOffset{Position & 63};
+
+        Words[WordIndex] |= static_cast<uint64>(Pattern.Bits) << BitOffset;
+
+        if(BitOffset + Pattern.NumUnits > 64)
+        {
+            Words[WordIndex + 1] |= static_cast<uint64>(Pattern.Bits) >> (64 - BitOffset);
+        }
+
+        Position += Pattern.NumUnits;
+    }
+
+    Stream.NumUnits = Position;
+    Stream.Words.resize((Position + 63) / 64);
+
+    return Stream;
+}
+
+FKeyingStream ReadKeyingFromFile(const std::string& PathToFile)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, std::ios::in | std::ios::binary | std::ios::ate);
+
+    FKeyingStream Stream{};
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return Stream;
+    }
+
+    const uint64 NumBytes{static_cast<uint64>(FStream.tellg())};
+
+    Stream.Words.resize((NumBytes + 7) / 8, 0);
+    Stream.NumUnits = NumBytes * 8;
+
+    FStream.seekg(0);
+    FStream.read(reinterpret_cast<char*>(Stream.Words.data()), static_cast<std::streamsize>(NumBytes));
+
+    FStream.close();
+
+    return Stream;
+}
+
+std::vector<char> DecodeKeyingToPlainText(const std::string& PathToFile, const FKeyingTiming& Timing)
+{
+    return DecodeKeyingStream(ReadKeyingFromFile(PathToFile), Timing);
+}
+
+std::vector<char> DecodeKeyingStream(const FKeyingStream& Stream, const FKeyingTiming& Timing)
+{
+    constexpr uint64 DashThreshold{2};
+    const uint64 CharacterGapThreshold{(1 + Timing.CharacterGapUnits + 1) / 2};
+    const uint64 WordGapThreshold{(Timing.CharacterGapUnits + Timing.WordGapUnits + 1) / 2};
+
+    std::array<char, 2 << Simd::int16_8::GetNumElements()> DecodeTable{};
+
+    for(uint16 PackedCode{0}; PackedCode < DecodeTable.size(); ++PackedCode)
+    {
+        DecodeTable[PackedCode] = GetCharacterFromPackedMorse(PackedCode);
+    }
+
+    //a character needs at least one key-down unit and a character gap, so this bounds the output and every store below can be unconditional
+    std::vector<char> PlainTextVector(Stream.NumUnits / 3 + 2);
+
+    char* const OutBegin{PlainTextVector.data()};
+    char* Out{OutBegin};
+
+    uint16 PackedCode{1};
+
+    auto OnRun = [&DecodeTable, &Out, OutBegin, &PackedCode, CharacterGapThreshold, WordGapThreshold](const bool bKeyDown, const uint64 NumUnits) -> void
+    {
+        if(bKeyDown)
+        {
+            //codes longer than the table are clamped to an index that decodes as Unrecognized
+            PackedCode = static_cast<uint16>(std::min<uint32>((PackedCode << 1) | (NumUnits > DashThreshold), DecodeTable.size() - 1));
+        }
+        else
+        {
+            const bool bCharacterEnd{NumUnits >= CharacterGapThreshold};
+
+            *Out = DecodeTable[PackedCode];
+            Out += bCharacterEnd && PackedCode != 1;
+
+            *Out = ' ';
+            Out += NumUnits >= WordGapThreshold && Out != OutBegin && Out[-1] != ' ';
+
+            PackedCode = bCharacterEnd ? 1 : PackedCode;
+        }
+    };
+
+    //every set bit of Word ^ (Word << 1) is a run boundary, so runs are walked with one tzcnt each instead of bit by bit
+    uint64 RunStart{0};
+    uint64 PreviousBit{0};
+
+    for(uint64 WordIndex{0}; WordIndex < Stream.Words.size(); ++WordIndex)
+    {
+        const uint64 ValidBits{std::min<uint64>(64, Stream.NumUnits - WordIndex * 64)};
+        const uint64 ValidMask{ValidBits == 64 ? ~static_cast<uint64>(0) : (static_cast<uint64>(1) << ValidBits) - 1};
+        const uint64 Word{Stream.Words[WordIndex] & ValidMask};
+
+        for(uint64 Transitions{(Word ^ ((Word << 1) | PreviousBit)) & ValidMask}; Transitions != 0; Transitions &= Transitions - 1)
+        {
+            const uint64 Bit{static_cast<uint64>(std::countr_zero(Transitions))};
+            const uint64 Position{WordIndex * 64 + Bit};
+
+            //the run that just ended has the opposite level of the bit that starts the next one
+            OnRun(((Word >> Bit) & 1) == 0, Position - RunStart);
+
+            RunStart = Position;
+        }
+
+        PreviousBit = (Word >> (ValidBits - 1)) & 1;
+    }
+
+    if(PreviousBit != 0)
+    {
+        OnRun(true, Stream.NumUnits - RunStart);
+    }
+
+    OnRun(false, CharacterGapThreshold);
+
+    PlainTextVector.resize(static_cast<size_t>(Out - OutBegin));
+
+    return PlainTextVector;
+}
+
+void WriteToFile(const std::string& PathToOutFile, const FKeyingStream& StreamToWrite)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToOutFile, std::ios::out | std::ios::binary);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToOutFile << std::endl;
+        return;
+    }
+
+    FStream.write(reinterpret_cast<const char*>(StreamToWrite.Words.data()), static_cast<std::streamsize>((StreamToWrite.NumUnits + 7) / 8));
+
+    FStream.close();
+}
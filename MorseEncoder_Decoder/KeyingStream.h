@@ -0,0 +1,46 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "FileReader.h"
+#include <string_view>
+
+//gap lengths in units of one dot, elements are always dot = 1 on, dash = 3 on, intra-character gap = 1 off
+struct FKeyingTiming
+{
+    uint32 CharacterGapUnits{3};
+    uint32 WordGapUnits{7};
+
+    //stretches the gaps so text sent with CharacterWpm elements averages EffectiveWpm
+    static FKeyingTiming Farnsworth(float32 CharacterWpm, float32 EffectiveWpm);
+};
+
+//one bit per unit, 1 = key down, filled from the least significant bit of each word
+struct FKeyingStream
+{
+    std::vector<uint64> Words;
+    uint64 NumUnits{0};
+};
+
+FKeyingStream EncodePlainTextToKeying(const std::string& PathToFile, const FKeyingTiming& Timing = {});
+
+FKeyingStream EncodeTextToKeying(std::string_view PlainText, const FKeyingTiming& Timing = {});
+
+FKeyingStream ReadKeyingFromFile(const std::string& PathToFile);
+
+std::vector<char> DecodeKeyingToPlainText(const std::string& PathToFile, const FKeyingTiming& Timing = {});
+
+//runs are classified against the midpoints of the given timing, so streams keyed with Farnsworth gaps need the same timing back
+std::vector<char> DecodeKeyingStream(const FKeyingStream& Stream, const FKeyingTiming& Timing = {});
+
+void WriteToFile(const std::string& PathToOutFile, const FKeyingStream& StreamToWrite);
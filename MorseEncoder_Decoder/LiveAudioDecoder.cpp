@@ -0,0 +1,83 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "LiveAudioDecoder.h"
+
+FLiveAudioDecoder::FLiveAudioDecoder(const uint32 InSampleRate, const float32 ToneFrequency, const float32 InitialWpm, const float32 BlockSeconds)
+    : SampleRate(InSampleRate)
+    , Detector(InSampleRate, ToneFrequency, BlockSeconds)
+    , Decoder(InitialWpm)
+    , BlockSamples(Detector.GetBlockSamples())
+    , HopSamples(std::max<size_t>(1, BlockSamples / 2))
+    , PendingTimestamps(std::max<size_t>(1, static_cast<size_t>(WarmUpSeconds * static_cast<float32>(InSampleRate)) / HopSamples))
+    , PendingMagnitudes(PendingTimestamps.size())
+    , SeedMagnitudes(PendingTimestamps.size())
+{
+    checkf(BlockSamples <= RingCapacity, "Detector block does not fit the ring buffer")
+}
+
+bool FLiveAudioDecoder::MeasureHop()
+{
+    //the window is timed at its centre, which is where an edge inside it shows up half way in the magnitude
+    PendingTimestamps[NumPending] = GetTimestamp(NumSamplesSeen - std::min<uint64>(NumSamplesSeen, BlockSamples / 2));
+    PendingMagnitudes[NumPending] = Detector.GetMagnitude(&Ring[WritePosition + RingCapacity - BlockSamples]);
+    ++NumPending;
+
+    if(!bSeeded && NumPending == PendingMagnitudes.size())
+    {
+        SeedThreshold();
+    }
+
+    return bSeeded;
+}
+
+void FLiveAudioDecoder::SeedThreshold()
+{
+    if(bSeeded)
+    {
+        return;
+    }
+
+    std::copy_n(PendingMagnitudes.begin(), NumPending, SeedMagnitudes.begin());
+
+    Threshold = MakeSeededThreshold(std::span<float32>{SeedMagnitudes.data(), NumPending});
+    bSeeded = true;
+}
+
+FKeyDecoderOutput FLiveAudioDecoder::ProcessMagnitude(const uint64 WindowTimestamp, const float32 Magnitude)
+{
+    if(Threshold.Update(Magnitude) != bKeyDown)
+    {
+        bKeyDown = !bKeyDown;
+
+        if(!bKeyDown)
+        {
+            LastKeyUp = WindowTimestamp;
+        }
+
+        return Decoder.OnKeyEvent(WindowTimestamp, bKeyDown);
+    }
+
+    return Decoder.Update(WindowTimestamp);
+}
+
+FKeyDecoderOutput FLiveAudioDecoder::FinishStream()
+{
+    if(bKeyDown)
+    {
+        bKeyDown = false;
+        LastKeyUp = GetTimestamp(NumSamplesSeen);
+        Decoder.OnKeyEvent(LastKeyUp, false);
+    }
+
+    return Decoder.Flush();
+}
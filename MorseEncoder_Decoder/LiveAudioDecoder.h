@@ -0,0 +1,148 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "ToneDecoder.h"
+#include <algorithm>
+
+//decodes raw mono PCM as it arrives, a detector window is evaluated every half block so a character comes out
+//as soon as the gap after it is long enough, everything is sized in the constructor and nothing allocates afterwards
+class FLiveAudioDecoder final
+{
+public:
+
+    static constexpr size_t RingCapacity{1024};
+    static constexpr size_t FrameSamples{128};
+
+    static constexpr uint32 DefaultSampleRate{8000};
+    static constexpr float32 DefaultToneFrequency{600.f};
+    static constexpr float32 DefaultWpm{20.f};
+
+    //the first magnitudes are held back and the threshold is seeded from their levels, as the batch decoder does,
+    //so noise in front of the signal cannot key before the threshold knows the noise floor
+    static constexpr float32 WarmUpSeconds{1.f};
+
+    FLiveAudioDecoder(uint32 InSampleRate, float32 ToneFrequency, float32 InitialWpm = DefaultWpm, float32 BlockSeconds = 0.005f);
+
+    //calls CallbackFunction(Character, LatencyMicroseconds) for every decoded character,
+    //the latency is stream time from the end of the character's last element to the sample that completed it
+    template<typename Callback>
+    void PushSamples(const int16* Samples, size_t NumSamples, Callback CallbackFunction)
+    {
+        while(NumSamples > 0)
+        {
+            const size_t NumToCopy{std::min({NumSamples, HopSamples - SamplesSinceHop, RingCapacity - WritePosition})};
+
+            //every sample is written twice, so any window ending at WritePosition is contiguous
+            std::copy_n(Samples, NumToCopy, &Ring[WritePosition]);
+            std::copy_n(Samples, NumToCopy, &Ring[WritePosition + RingCapacity]);
+
+            WritePosition = (WritePosition + NumToCopy) & (RingCapacity - 1);
+            NumSamplesSeen += NumToCopy;
+            SamplesSinceHop += NumToCopy;
+            Samples += NumToCopy;
+            NumSamples -= NumToCopy;
+
+            if(SamplesSinceHop == HopSamples)
+            {
+                SamplesSinceHop = 0;
+
+                if(MeasureHop())
+                {
+                    DecodePending(CallbackFunction);
+                }
+            }
+        }
+    }
+
+    template<typename Callback>
+    void Finish(Callback CallbackFunction)
+    {
+        //a stream shorter than the warm-up is seeded from what there is
+        SeedThreshold();
+        DecodePending(CallbackFunction);
+
+        for(const char Character : FinishStream())
+        {
+            CallbackFunction(Character, GetTimestamp(NumSamplesSeen) - LastKeyUp);
+        }
+    }
+
+    float32 GetWordsPerMinute() const {return Decoder.GetWordsPerMinute();}
+
+private:
+
+    //the latency of held back characters includes the time they were held
+    template<typename Callback>
+    void DecodePending(Callback CallbackFunction)
+    {
+        for(size_t Index{0}; Index < NumPending; ++Index)
+        {
+            for(const char Character : ProcessMagnitude(PendingTimestamps[Index], PendingMagnitudes[Index]))
+            {
+                CallbackFunction(Character, GetTimestamp(NumSamplesSeen) - LastKeyUp);
+            }
+        }
+
+        NumPending = 0;
+    }
+
+    //queues the magnitude of the window that just completed, false while the warm-up still holds it back
+    bool MeasureHop();
+
+    void SeedThreshold();
+
+    FKeyDecoderOutput ProcessMagnitude(uint64 WindowTimestamp, float32 Magnitude);
+
+    FKeyDecoderOutput FinishStream();
+
+    uint64 GetTimestamp(uint64 Sample) const {return Sample * 1000000 / SampleRate;}
+
+    uint32 SampleRate;
+
+    FToneDetector Detector;
+    FEnvelopeThreshold Threshold{};
+    bool bSeeded{false};
+    FAdaptiveKeyDecoder Decoder;
+
+    size_t BlockSamples;
+    size_t HopSamples;
+
+    std::array<int16, RingCapacity * 2> Ring{};
+    size_t WritePosition{0};
+    size_t SamplesSinceHop{0};
+    uint64 NumSamplesSeen{0};
+
+    uint64 LastKeyUp{0};
+    bool bKeyDown{false};
+
+    //a single entry once seeded, the whole warm-up before
+    std::vector<uint64> PendingTimestamps;
+    std::vector<float32> PendingMagnitudes;
+    std::vector<float32> SeedMagnitudes;
+    size_t NumPending{0};
+};
+
+template<typename Callback>
+void ForEachLiveAudioCharacter(std::istream& Stream, FLiveAudioDecoder& Decoder, Callback CallbackFunction)
+{
+    std::array<int16, FLiveAudioDecoder::FrameSamples> Frame{};
+
+    //small frames keep the wait for a full read short, a partial read only happens at the end of the stream
+    while(Stream.read(reinterpret_cast<char*>(Frame.data()), sizeof(Frame)) || Stream.gcount() > 0)
+    {
+        Decoder.PushSamples(Frame.data(), static_cast<size_t>(Stream.gcount()) / sizeof(int16), CallbackFunction);
+    }
+
+    Decoder.Finish(CallbackFunction);
+}
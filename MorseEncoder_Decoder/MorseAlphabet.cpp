@@ -0,0 +1,740 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "MorseAlphabet.h"
+#include "MorseSink.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <span>
+#include <sstream>
+#include <unordered_map>
+#include <sys/stat.h>
+
+namespace Alphabet
+{
+    constexpr size_t ReadChunkBytes{1 << 20};
+
+    constexpr Simd::int16_8 NewWordChar{MorseCodes::NewWord, 0, 0, 0, 0, 0, 0, 0};
+    constexpr Simd::int16_8 SeparateCharacterChar{MorseCodes::SeparateChar, 0, 0, 0, 0, 0, 0, 0};
+
+    //Texts is indexed with a byte
+    constexpr size_t MaxTexts{256};
+
+    //a UTF-8 character or a prosign name, the decoder's output blocks have room for no more
+    constexpr size_t MaxTextBytes{MorseCodes::MaxProsignTextBytes};
+
+    struct FLetter
+    {
+        char32_t CodePoint;
+        std::string_view Pattern;
+    };
+
+    //a character encoded like Letter without a text of its own (lowercase, final forms, small kana)
+    struct FAlias
+    {
+        char32_t CodePoint;
+        char32_t Letter;
+    };
+
+    constexpr std::array<FLetter, 32> CyrillicLetters
+    {
+        FLetter{U'А', ".-"}, FLetter{U'Б', "-..."}, FLetter{U'В', ".--"}, FLetter{U'Г', "--."}, FLetter{U'Д', "-.."}, FLetter{U'Е', "."}, FLetter{U'Ж', "...-"}, FLetter{U'З', "--.."},
+        FLetter{U'И', ".."}, FLetter{U'Й', ".---"}, FLetter{U'К', "-.-"}, FLetter{U'Л', ".-.."}, FLetter{U'М', "--"}, FLetter{U'Н', "-."}, FLetter{U'О', "---"}, FLetter{U'П', ".--."},
+        FLetter{U'Р', ".-."}, FLetter{U'С', "..."}, FLetter{U'Т', "-"}, FLetter{U'У', "..-"}, FLetter{U'Ф', "..-."}, FLetter{U'Х', "...."}, FLetter{U'Ц', "-.-."}, FLetter{U'Ч', "---."},
+        FLetter{U'Ш', "----"}, FLetter{U'Щ', "--.-"}, FLetter{U'Ъ', "--.--"}, FLetter{U'Ы', "-.--"}, FLetter{U'Ь', "-..-"}, FLetter{U'Э', "..-.."}, FLetter{U'Ю', "..--"}, FLetter{U'Я', ".-.-"}
+    };
+
+    constexpr std::array<FLetter, 24> GreekLetters
+    {
+        FLetter{U'Α', ".-"}, FLetter{U'Β', "-..."}, FLetter{U'Γ', "--."}, FLetter{U'Δ', "-.."}, FLetter{U'Ε', "."}, FLetter{U'Ζ', "--.."}, FLetter{U'Η', "...."}, FLetter{U'Θ', "-.-."},
+        FLetter{U'Ι', ".."}, FLetter{U'Κ', "-.-"}, FLetter{U'Λ', ".-.."}, FLetter{U'Μ', "--"}, FLetter{U'Ν', "-."}, FLetter{U'Ξ', "-..-"}, FLetter{U'Ο', "---"}, FLetter{U'Π', ".--."},
+        FLetter{U'Ρ', ".-."}, FLetter{U'Σ', "..."}, FLetter{U'Τ', "-"}, FLetter{U'Υ', "-.--"}, FLetter{U'Φ', "..-."}, FLetter{U'Χ', "----"}, FLetter{U'Ψ', "--.-"}, FLetter{U'Ω', ".--"}
+    };
+
+    //vowels with a tonos or dialytika are sent without it
+    constexpr std::array<FAlias, 18> GreekAliases
+    {
+        FAlias{U'Ά', U'Α'}, FAlias{U'Έ', U'Ε'}, FAlias{U'Ή', U'Η'}, FAlias{U'Ί', U'Ι'}, FAlias{U'Ό', U'Ο'}, FAlias{U'Ύ', U'Υ'}, FAlias{U'Ώ', U'Ω'}, FAlias{U'Ϊ', U'Ι'}, FAlias{U'Ϋ', U'Υ'},
+        FAlias{U'ά', U'Α'}, FAlias{U'έ', U'Ε'}, FAlias{U'ή', U'Η'}, FAlias{U'ί', U'Ι'}, FAlias{U'ό', U'Ο'}, FAlias{U'ύ', U'Υ'}, FAlias{U'ώ', U'Ω'}, FAlias{U'ϊ', U'Ι'}, FAlias{U'ϋ', U'Υ'}
+    };
+
+    constexpr std::array<FLetter, 22> HebrewLetters
+    {
+        FLetter{U'א', ".-"}, FLetter{U'ב', "-..."}, FLetter{U'ג', "--."}, FLetter{U'ד', "-.."}, FLetter{U'ה', "---"}, FLetter{U'ו', "."}, FLetter{U'ז', "--.."}, FLetter{U'ח', "...."},
+        FLetter{U'ט', "..-"}, FLetter{U'י', ".."}, FLetter{U'כ', "-.-"}, FLetter{U'ל', ".-.."}, FLetter{U'מ', "--"}, FLetter{U'נ', "-."}, FLetter{U'ס', "-.-."}, FLetter{U'ע', ".---"},
+        FLetter{U'פ', ".--."}, FLetter{U'צ', ".--"}, FLetter{U'ק', "--.-"}, FLetter{U'ר', ".-."}, FLetter{U'ש', "..."}, FLetter{U'ת', "-"}
+    };
+
+    constexpr std::array<FAlias, 5> HebrewAliases
+    {
+        FAlias{U'ך', U'כ'}, FAlias{U'ם', U'מ'}, FAlias{U'ן', U'נ'}, FAlias{U'ף', U'פ'}, FAlias{U'ץ', U'צ'}
+    };
+
+    constexpr std::array<FLetter, 29> ArabicLetters
+    {
+        FLetter{U'ا', ".-"}, FLetter{U'ب', "-..."}, FLetter{U'ت', "-"}, FLetter{U'ث', "-.-."}, FLetter{U'ج', ".---"}, FLetter{U'ح', "...."}, FLetter{U'خ', "---"}, FLetter{U'د', "-.."},
+        FLetter{U'ذ', "--.."}, FLetter{U'ر', ".-."}, FLetter{U'ز', "---."}, FLetter{U'س', "..."}, FLetter{U'ش', "----"}, FLetter{U'ص', "-..-"}, FLetter{U'ض', "...-"}, FLetter{U'ط', "..-"},
+        FLetter{U'ظ', "-.--"}, FLetter{U'ع', ".-.-"}, FLetter{U'غ', "--."}, FLetter{U'ف', "..-."}, FLetter{U'ق', "--.-"}, FLetter{U'ك', "-.-"}, FLetter{U'ل', ".-.."}, FLetter{U'م', "--"},
+        FLetter{U'ن', "-."}, FLetter{U'ه', "..-.."}, FLetter{U'و', ".--"}, FLetter{U'ي', ".."}, FLetter{U'ء', "."}
+    };
+
+    constexpr std::array<FLetter, 53> WabunLetters
+    {
+        FLetter{U'イ', ".-"}, FLetter{U'ロ', ".-.-"}, FLetter{U'ハ', "-..."}, FLetter{U'ニ', "-.-."}, FLetter{U'ホ', "-.."}, FLetter{U'ヘ', "."}, FLetter{U'ト', "..-.."}, FLetter{U'チ', "..-."},
+        FLetter{U'リ', "--."}, FLetter{U'ヌ', "...."}, FLetter{U'ル', "-.--."}, FLetter{U'ヲ', ".---"}, FLetter{U'ワ', "-.-"}, FLetter{U'カ', ".-.."}, FLetter{U'ヨ', "--"}, FLetter{U'タ', "-."},
+        FLetter{U'レ', "---"}, FLetter{U'ソ', "---."}, FLetter{U'ツ', ".--."}, FLetter{U'ネ', "--.-"}, FLetter{U'ナ', ".-."}, FLetter{U'ラ', "..."}, FLetter{U'ム', "-"}, FLetter{U'ウ', "..-"},
+        FLetter{U'ヰ', ".-..-"}, FLetter{U'ノ', "..--"}, FLetter{U'オ', ".-..."}, FLetter{U'ク', "...-"}, FLetter{U'ヤ', ".--"}, FLetter{U'マ', "-..-"}, FLetter{U'ケ', "-.--"}, FLetter{U'フ', "--.."},
+        FLetter{U'コ', "----"}, FLetter{U'エ', "-.---"}, FLetter{U'テ', ".-.--"}, FLetter{U'ア', "--.--"}, FLetter{U'サ', "-.-.-"}, FLetter{U'キ', "-.-.."}, FLetter{U'ユ', "-..--"}, FLetter{U'メ', "-...-"},
+        FLetter{U'ミ', "..-.-"}, FLetter{U'シ', "--.-."}, FLetter{U'ヱ', ".--.."}, FLetter{U'ヒ', "--..-"}, FLetter{U'モ', "-..-."}, FLetter{U'セ', ".---."}, FLetter{U'ス', "---.-"}, FLetter{U'ン', ".-.-."},
+        FLetter{U'゛', ".."}, FLetter{U'゜', "..--."}, FLetter{U'ー', ".--.-"}, FLetter{U'、', ".-.-.-"}, FLetter{U'」', ".-.-.."}
+    };
+
+    constexpr std::array<FAlias, 9> WabunAliases
+    {
+        FAlias{U'ァ', U'ア'}, FAlias{U'ィ', U'イ'}, FAlias{U'ゥ', U'ウ'}, FAlias{U'ェ', U'エ'}, FAlias{U'ォ', U'オ'}, FAlias{U'ッ', U'ツ'}, FAlias{U'ャ', U'ヤ'}, FAlias{U'ュ', U'ユ'}, FAlias{U'ョ', U'ヨ'}
+    };
+
+    //katakana written as the plain kana and a voicing mark, the voiced kana follows its plain one, the semi-voiced one comes after that
+    constexpr std::array<char32_t, 15> VoicedKana{U'カ', U'キ', U'ク', U'ケ', U'コ', U'サ', U'シ', U'ス', U'セ', U'ソ', U'タ', U'チ', U'ツ', U'テ', U'ト'};
+    constexpr std::array<char32_t, 5> SemiVoicedKana{U'ハ', U'ヒ', U'フ', U'ヘ', U'ホ'};
+
+    constexpr char32_t HiraganaOffset{U'ア' - U'あ'};
+
+    //1 for ASCII and bytes that cannot start a sequence
+    uint32 GetSequenceLength(const uint8 LeadByte)
+    {
+        return LeadByte < 0xC0 ? 1 : LeadByte < 0xE0 ? 2 : LeadByte < 0xF0 ? 3 : 4;
+    }
+
+    //the length of the character at Text, 0 for invalid or cut off UTF-8
+    uint32 DecodeUtf8(const char* Text, const size_t NumBytes, char32_t& OutCodePoint)
+    {
+        const uint8 LeadByte{static_cast<uint8>(Text[0])};
+        const uint32 Length{GetSequenceLength(LeadByte)};
+
+        if(LeadByte < 0x80)
+        {
+            OutCodePoint = LeadByte;
+            return 1;
+        }
+        if(LeadByte < 0xC2 || LeadByte > 0xF4 || Length > NumBytes)
+        {
+            return 0;
+        }
+
+        char32_t CodePoint{static_cast<char32_t>(LeadByte & (0x7F >> Length))};
+
+        for(uint32 Byte{1}; Byte < Length; ++Byte)
+        {
+            const uint8 Continuation{static_cast<uint8>(Text[Byte])};
+
+            if((Continuation & 0xC0) != 0x80)
+            {
+                return 0;
+            }
+
+            CodePoint = (CodePoint << 6) | (Continuation & 0x3F);
+        }
+
+        //over-long forms, surrogates and code points past U+10FFFF
+        constexpr std::array<char32_t, 5> MinCodePoints{0, 0, 0x80, 0x800, 0x10000};
+
+        if(CodePoint < MinCodePoints[Length] || (CodePoint >= 0xD800 && CodePoint <= 0xDFFF) || CodePoint > 0x10FFFF)
+        {
+            return 0;
+        }
+
+        OutCodePoint = CodePoint;
+        return Length;
+    }
+
+    std::string EncodeUtf8(const char32_t CodePoint)
+    {
+        if(CodePoint < 0x80)
+        {
+            return std::string(1, static_cast<char>(CodePoint));
+        }
+        if(CodePoint < 0x800)
+        {
+            return std::string{static_cast<char>(0xC0 | (CodePoint >> 6)), static_cast<char>(0x80 | (CodePoint & 0x3F))};
+        }
+        if(CodePoint < 0x10000)
+        {
+            return std::string{static_cast<char>(0xE0 | (CodePoint >> 12)), static_cast<char>(0x80 | ((CodePoint >> 6) & 0x3F)), static_cast<char>(0x80 | (CodePoint & 0x3F))};
+        }
+
+        return std::string{static_cast<char>(0xF0 | (CodePoint >> 18)), static_cast<char>(0x80 | ((CodePoint >> 12) & 0x3F)), static_cast<char>(0x80 | ((CodePoint >> 6) & 0x3F)), static_cast<char>(0x80 | (CodePoint & 0x3F))};
+    }
+
+    bool ParsePattern(const std::string_view Pattern, uint16& OutPackedCode)
+    {
+        if(Pattern.empty() || Pattern.size() > MorseCodes::MaxPackedElements)
+        {
+            return false;
+        }
+
+        uint16 PackedCode{1};
+
+        for(const char Element : Pattern)
+        {
+            if(Element != '.' && Element != static_cast<char>(MorseCodes::Short) && Element != static_cast<char>(MorseCodes::Long))
+            {
+                return false;
+            }
+
+            PackedCode = static_cast<uint16>((PackedCode << 1) | (Element == static_cast<char>(MorseCodes::Long)));
+        }
+
+        OutPackedCode = PackedCode;
+
+        //fifteen longs pack to the code every decoder saturates to, which has to stay Unrecognized
+        return PackedCode != 0xFFFF;
+    }
+
+    //a code that already has a text keeps it, so the first definition of a shared code wins
+    void AddText(FMorseAlphabet& Alphabet, const std::string_view Text, const uint16 PackedCode)
+    {
+        if(Alphabet.DecodeTable[PackedCode] == 0)
+        {
+            Alphabet.DecodeTable[PackedCode] = static_cast<uint8>(Alphabet.Texts.size());
+            Alphabet.Texts.emplace_back(Text);
+        }
+    }
+
+    //lowercase letters without a code of their own are encoded like their capital
+    void FoldCase(FMorseAlphabet& Alphabet)
+    {
+        for(char Character{'a'}; Character <= 'z'; ++Character)
+        {
+            uint16& PackedCode{Alphabet.EncodeTable[static_cast<uint8>(Character)]};
+
+            PackedCode = PackedCode != 0 ? PackedCode : Alphabet.Encode(static_cast<char>(Character - 32));
+        }
+    }
+
+    FMorseAlphabet National(const std::span<const FLetter> Letters, const std::span<const FAlias> Aliases)
+    {
+        FMorseAlphabet Alphabet{};
+
+        for(const FLetter& Letter : Letters)
+        {
+            uint16 PackedCode{0};
+            ParsePattern(Letter.Pattern, PackedCode);
+
+            Alphabet.WideEncodeTable[Letter.CodePoint] = std::array<uint16, 2>{PackedCode, 0};
+            AddText(Alphabet, EncodeUtf8(Letter.CodePoint), PackedCode);
+        }
+
+        for(const FAlias& Alias : Aliases)
+        {
+            Alphabet.WideEncodeTable[Alias.CodePoint] = Alphabet.WideEncodeTable.Get(Alias.Letter);
+        }
+
+        //digits and punctuation, the latin letters are left out so they do not decode as national ones
+        for(const char Character : MorseCodes::Alphabet)
+        {
+            if(Character < 'A' || Character > 'Z')
+            {
+                const uint16 PackedCode{PackMorseCode(GetMorseFromCharacter(Character))};
+
+                Alphabet.EncodeTable[static_cast<uint8>(Character)] = PackedCode;
+                AddText(Alphabet, std::string_view{&Character, 1}, PackedCode);
+            }
+        }
+
+        for(const MorseCodes::FProsign& Prosign : MorseCodes::Prosigns)
+        {
+            AddText(Alphabet, "<" + std::string{Prosign.Name} + ">", GetPackedMorseFromProsign(Prosign.Name));
+        }
+
+        return Alphabet;
+    }
+
+    //lowercase letters of alphabets with cases sit at a fixed distance from their capital
+    void AddLowercase(FMorseAlphabet& Alphabet, const std::span<const FLetter> Letters, const char32_t Offset)
+    {
+        for(const FLetter& Letter : Letters)
+        {
+            Alphabet.WideEncodeTable[Letter.CodePoint + Offset] = Alphabet.WideEncodeTable.Get(Letter.CodePoint);
+        }
+    }
+
+    bool GetSourceStatus(const std::string& PathToFile, FMorseAlphabetCacheHeader& OutHeader)
+    {
+        struct stat FileStatus{};
+
+        if(stat(PathToFile.c_str(), &FileStatus) != 0)
+        {
+            return false;
+        }
+
+        OutHeader.SourceBytes = static_cast<uint64>(FileStatus.st_size);
+        OutHeader.SourceWriteTime = static_cast<int64>(FileStatus.st_mtim.tv_sec) * 1000000000 + static_cast<int64>(FileStatus.st_mtim.tv_nsec);
+        return true;
+    }
+
+    bool ReadCache(const std::string& PathToCache, const FMorseAlphabetCacheHeader& Source, FMorseAlphabet& OutAlphabet)
+    {
+        std::fstream FStream{};
+
+        FStream.open(PathToCache, std::ios::in | std::ios::binary);
+
+        FMorseAlphabetCacheHeader Header{};
+
+        if(!FStream || !FStream.read(reinterpret_cast<char*>(&Header), sizeof(FMorseAlphabetCacheHeader)))
+        {
+            return false;
+        }
+
+        if(Header.Magic != Source.Magic || Header.SourceBytes != Source.SourceBytes || Header.SourceWriteTime != Source.SourceWriteTime || Header.NumTexts == 0 || Header.NumTexts > MaxTexts || Header.NumWidePages == 0 || Header.NumWidePages > FMorseAlphabetWideTable::NumPageIndices)
+        {
+            return false;
+        }
+
+        FMorseAlphabet Alphabet{};
+        std::string TextBytes(Header.TextBytes, '\0');
+        Alphabet.WideEncodeTable.Pages.resize(Header.NumWidePages);
+
+        FStream.read(reinterpret_cast<char*>(Alphabet.EncodeTable.data()), sizeof(Alphabet.EncodeTable));
+        FStream.read(reinterpret_cast<char*>(Alphabet.DecodeTable.data()), sizeof(Alphabet.DecodeTable));
+        FStream.read(TextBytes.data(), static_cast<std::streamsize>(TextBytes.size()));
+        FStream.read(reinterpret_cast<char*>(Alphabet.WideEncodeTable.PageIndices.data()), sizeof(Alphabet.WideEncodeTable.PageIndices));
+        FStream.read(reinterpret_cast<char*>(Alphabet.WideEncodeTable.Pages.data()), static_cast<std::streamsize>(Header.NumWidePages * sizeof(FMorseAlphabetWideTable::FPage)));
+
+        if(!FStream)
+        {
+            return false;
+        }
+
+        Alphabet.Texts.clear();
+
+        for(size_t Offset{0}; Offset < TextBytes.size(); Offset += 1 + static_cast<uint8>(TextBytes[Offset]))
+        {
+            Alphabet.Texts.emplace_back(TextBytes, Offset + 1, static_cast<uint8>(TextBytes[Offset]));
+        }
+
+        if(Alphabet.Texts.size() != Header.NumTexts || *std::max_element(Alphabet.DecodeTable.begin(), Alphabet.DecodeTable.end()) >= Header.NumTexts || Alphabet.DecodeTable[0xFFFF] != 0)
+        {
+            return false;
+        }
+
+        if(std::any_of(Alphabet.Texts.begin(), Alphabet.Texts.end(), [](const std::string& Text) -> bool {return Text.empty() || Text.size() > MaxTextBytes;}))
+        {
+            return false;
+        }
+
+        const FMorseAlphabetWideTable& WideTable{Alphabet.WideEncodeTable};
+
+        if(*std::max_element(WideTable.PageIndices.begin(), WideTable.PageIndices.end()) >= Header.NumWidePages || WideTable.Pages.front() != FMorseAlphabetWideTable::FPage{})
+        {
+            return false;
+        }
+
+        OutAlphabet = std::move(Alphabet);
+        return true;
+    }
+
+    void WriteCache(const std::string& PathToCache, FMorseAlphabetCacheHeader Header, const FMorseAlphabet& Alphabet)
+    {
+        std::string TextBytes{};
+
+        for(const std::string& Text : Alphabet.Texts)
+        {
+            TextBytes.push_back(static_cast<char>(Text.size()));
+            TextBytes.append(Text);
+        }
+
+        Header.NumTexts = static_cast<uint32>(Alphabet.Texts.size());
+        Header.TextBytes = static_cast<uint32>(TextBytes.size());
+        Header.NumWidePages = static_cast<uint32>(Alphabet.WideEncodeTable.Pages.size());
+
+        std::fstream FStream{};
+
+        FStream.open(PathToCache, std::ios::out | std::ios::binary);
+
+        //a missing cache only costs the next start the compile
+        if(!FStream)
+        {
+            return;
+        }
+
+        FStream.write(reinterpret_cast<const char*>(&Header), sizeof(FMorseAlphabetCacheHeader));
+        FStream.write(reinterpret_cast<const char*>(Alphabet.EncodeTable.data()), sizeof(Alphabet.EncodeTable));
+        FStream.write(reinterpret_cast<const char*>(Alphabet.DecodeTable.data()), sizeof(Alphabet.DecodeTable));
+        FStream.write(TextBytes.data(), static_cast<std::streamsize>(TextBytes.size()));
+        FStream.write(reinterpret_cast<const char*>(Alphabet.WideEncodeTable.PageIndices.data()), sizeof(Alphabet.WideEncodeTable.PageIndices));
+        FStream.write(reinterpret_cast<const char*>(Alphabet.WideEncodeTable.Pages.data()), static_cast<std::streamsize>(Alphabet.WideEncodeTable.Pages.size() * sizeof(FMorseAlphabetWideTable::FPage)));
+
+        FStream.close();
+    }
+}
+
+std::array<uint16, 2>& FMorseAlphabetWideTable::operator[](const char32_t CodePoint)
+{
+    uint16& PageIndex{PageIndices[CodePoint >> PageBits]};
+
+    if(PageIndex == 0)
+    {
+        PageIndex = static_cast<uint16>(Pages.size());
+        Pages.emplace_back();
+    }
+
+    return Pages[PageIndex][CodePoint & ((1 << PageBits) - 1)];
+}
+
+FMorseAlphabet FMorseAlphabet::BuiltIn()
+{
+    FMorseAlphabet Alphabet{};
+
+    //characters first, AR, BT, KN and AS decode as the character they share their code with
+    for(const char Character : MorseCodes::Alphabet)
+    {
+        const uint16 PackedCode{PackMorseCode(GetMorseFromCharacter(Character))};
+
+        Alphabet.EncodeTable[static_cast<uint8>(Character)] = PackedCode;
+        Alphabet::AddText(Alphabet, std::string_view{&Character, 1}, PackedCode);
+    }
+
+    for(const MorseCodes::FProsign& Prosign : MorseCodes::Prosigns)
+    {
+        Alphabet::AddText(Alphabet, "<" + std::string{Prosign.Name} + ">", GetPackedMorseFromProsign(Prosign.Name));
+    }
+
+    Alphabet::FoldCase(Alphabet);
+
+    return Alphabet;
+}
+
+FMorseAlphabet FMorseAlphabet::Cyrillic()
+{
+    FMorseAlphabet Alphabet{Alphabet::National(Alphabet::CyrillicLetters, {})};
+    Alphabet::AddLowercase(Alphabet, Alphabet::CyrillicLetters, U'а' - U'А');
+
+    //Ё is sent as Е
+    Alphabet.WideEncodeTable[U'Ё'] = Alphabet.WideEncodeTable.Get(U'Е');
+    Alphabet.WideEncodeTable[U'ё'] = Alphabet.WideEncodeTable.Get(U'Е');
+
+    return Alphabet;
+}
+
+FMorseAlphabet FMorseAlphabet::Greek()
+{
+    FMorseAlphabet Alphabet{Alphabet::National(Alphabet::GreekLetters, Alphabet::GreekAliases)};
+    Alphabet::AddLowercase(Alphabet, Alphabet::GreekLetters, U'α' - U'Α');
+
+    Alphabet.WideEncodeTable[U'ς'] = Alphabet.WideEncodeTable.Get(U'Σ');
+
+    return Alphabet;
+}
+
+FMorseAlphabet FMorseAlphabet::Hebrew()
+{
+    return Alphabet::National(Alphabet::HebrewLetters, Alphabet::HebrewAliases);
+}
+
+FMorseAlphabet FMorseAlphabet::Arabic()
+{
+    return Alphabet::National(Alphabet::ArabicLetters, {});
+}
+
+FMorseAlphabet FMorseAlphabet::Wabun()
+{
+    FMorseAlphabet Alphabet{Alphabet::National(Alphabet::WabunLetters, Alphabet::WabunAliases)};
+
+    const uint16 Voiced{Alphabet.WideEncodeTable.Get(U'゛')[0]};
+    const uint16 SemiVoiced{Alphabet.WideEncodeTable.Get(U'゜')[0]};
+
+    for(const char32_t Kana : Alphabet::VoicedKana)
+    {
+        Alphabet.WideEncodeTable[Kana + 1] = std::array<uint16, 2>{Alphabet.WideEncodeTable.Get(Kana)[0], Voiced};
+    }
+    for(const char32_t Kana : Alphabet::SemiVoicedKana)
+    {
+        Alphabet.WideEncodeTable[Kana + 1] = std::array<uint16, 2>{Alphabet.WideEncodeTable.Get(Kana)[0], Voiced};
+        Alphabet.WideEncodeTable[Kana + 2] = std::array<uint16, 2>{Alphabet.WideEncodeTable.Get(Kana)[0], SemiVoiced};
+    }
+
+    Alphabet.WideEncodeTable[U'ヴ'] = std::array<uint16, 2>{Alphabet.WideEncodeTable.Get(U'ウ')[0], Voiced};
+
+    //every katakana from small a to small ke has a hiragana at the same distance
+    for(char32_t Kana{U'ァ'}; Kana <= U'ヶ'; ++Kana)
+    {
+        if(const std::array<uint16, 2> PackedCodes{Alphabet.WideEncodeTable.Get(Kana)}; PackedCodes[0] != 0)
+        {
+            Alphabet.WideEncodeTable[Kana - Alphabet::HiraganaOffset] = PackedCodes;
+        }
+    }
+
+    return Alphabet;
+}
+
+bool ParseMorseAlphabet(const std::string_view NameOrPath, FMorseAlphabet& OutAlphabet)
+{
+    if(NameOrPath == "latin")
+    {
+        OutAlphabet = FMorseAlphabet::BuiltIn();
+    }
+    else if(NameOrPath == "cyrillic")
+    {
+        OutAlphabet = FMorseAlphabet::Cyrillic();
+    }
+    else if(NameOrPath == "greek")
+    {
+        OutAlphabet = FMorseAlphabet::Greek();
+    }
+    else if(NameOrPath == "hebrew")
+    {
+        OutAlphabet = FMorseAlphabet::Hebrew();
+    }
+    else if(NameOrPath == "arabic")
+    {
+        OutAlphabet = FMorseAlphabet::Arabic();
+    }
+    else if(NameOrPath == "wabun")
+    {
+        OutAlphabet = FMorseAlphabet::Wabun();
+    }
+    else
+    {
+        return LoadMorseAlphabet(std::string{NameOrPath}, OutAlphabet);
+    }
+
+    return true;
+}
+
+bool LoadMorseAlphabet(const std::string& PathToFile, FMorseAlphabet& OutAlphabet)
+{
+    const std::string PathToCache{PathToFile + ".cache"};
+
+    FMorseAlphabetCacheHeader Source{};
+
+    if(!Alphabet::GetSourceStatus(PathToFile, Source))
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return false;
+    }
+
+    if(Alphabet::ReadCache(PathToCache, Source, OutAlphabet))
+    {
+        return true;
+    }
+
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, std::ios::in);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return false;
+    }
+
+    FMorseAlphabet Alphabet{};
+
+    //the line each character and pattern was defined on, 0 while it is free
+    std::unordered_map<char32_t, uint32> CharacterLines{};
+    std::vector<uint32> PatternLines(Alphabet.DecodeTable.size(), 0);
+
+    bool bConflicts{false};
+    uint32 LineNumber{0};
+
+    for(std::string Line{}; std::getline(FStream, Line);)
+    {
+        ++LineNumber;
+
+        std::istringstream Fields{Line};
+        std::string Character{};
+        std::string Pattern{};
+        std::string Rest{};
+
+        Fields >> Character >> Pattern >> Rest;
+
+        if(Character.empty() || Line.rfind("//", 0) == 0)
+        {
+            continue;
+        }
+
+        uint16 PackedCode{0};
+        char32_t CodePoint{0};
+
+        if(Alphabet::DecodeUtf8(Character.data(), Character.size(), CodePoint) != Character.size() || !Rest.empty() || !Alphabet::ParsePattern(Pattern, PackedCode))
+        {
+            std::cerr << PathToFile << ":" << LineNumber << ": expected a character and a pattern of 1 to " << MorseCodes::MaxPackedElements << " . or -" << std::endl;
+            bConflicts = true;
+            continue;
+        }
+
+        if(CharacterLines[CodePoint] != 0)
+        {
+            std::cerr << PathToFile << ":" << LineNumber << ": " << Character << " is already defined on line " << CharacterLines[CodePoint] << std::endl;
+            bConflicts = true;
+            continue;
+        }
+        if(PatternLines[PackedCode] != 0)
+        {
+            std::cerr << PathToFile << ":" << LineNumber << ": " << Pattern << " is already used by " << Alphabet.Decode(PackedCode) << " on line " << PatternLines[PackedCode] << std::endl;
+            bConflicts = true;
+            continue;
+        }
+        if(Alphabet.Texts.size() == Alphabet::MaxTexts)
+        {
+            std::cerr << PathToFile << ":" << LineNumber << ": more than " << Alphabet::MaxTexts - 1 << " characters" << std::endl;
+            bConflicts = true;
+            break;
+        }
+
+        CharacterLines[CodePoint] = LineNumber;
+        PatternLines[PackedCode] = LineNumber;
+
+        if(CodePoint < 0x80)
+        {
+            Alphabet.EncodeTable[CodePoint] = PackedCode;
+        }
+        else
+        {
+            Alphabet.WideEncodeTable[CodePoint] = std::array<uint16, 2>{PackedCode, 0};
+        }
+
+        Alphabet::AddText(Alphabet, Character, PackedCode);
+    }
+
+    FStream.close();
+
+    if(bConflicts)
+    {
+        return false;
+    }
+
+    Alphabet::FoldCase(Alphabet);
+    Alphabet::WriteCache(PathToCache, Source, Alphabet);
+
+    OutAlphabet = std::move(Alphabet);
+    return true;
+}
+
+std::vector<Simd::int16_8> EncodePlainTextToMorse(const std::string& PathToFile, const FMorseAlphabet& Alphabet)
+{
+    std::vector<Simd::int16_8> MorseCodeVector{};
+
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, std::ios::in | std::ios::binary);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return MorseCodeVector;
+    }
+
+    auto AppendCode = [&MorseCodeVector](const uint16 PackedCode) -> void
+    {
+        if likely(PackedCode != 0)
+        {
+            AppendPackedMorseCode(PackedCode, MorseCodeVector);
+            MorseCodeVector.emplace_back(Alphabet::SeparateCharacterChar);
+        }
+    };
+
+    auto EncodeAscii = [&MorseCodeVector, &Alphabet, &AppendCode](const char Character) -> void
+    {
+        if unlikely(Character == ' ')
+        {
+            //the word space takes the place of the separator in front of it
+            if(!MorseCodeVector.empty() && MorseCodeVector.back() == Alphabet::SeparateCharacterChar)
+            {
+                MorseCodeVector.back() = Alphabet::NewWordChar;
+            }
+        }
+        else
+        {
+            AppendCode(Alphabet.Encode(Character));
+        }
+    };
+
+    //a character cut off at the end of a chunk is moved in front of the next one
+    std::vector<char> Chunk(Alphabet::ReadChunkBytes + 3);
+    size_t NumCarried{0};
+
+    while(FStream.read(Chunk.data() + NumCarried, static_cast<std::streamsize>(Alphabet::ReadChunkBytes)) || FStream.gcount() > 0)
+    {
+        const size_t NumBytes{NumCarried + static_cast<size_t>(FStream.gcount())};
+        const bool bLastChunk{FStream.eof()};
+
+        size_t Index{0};
+
+        while(Index < NumBytes)
+        {
+            if likely(Index + 32 <= NumBytes)
+            {
+                const uint32 NonAscii{static_cast<uint32>(_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Chunk[Index]))))};
+                const size_t NumAscii{NonAscii == 0 ? 32 : static_cast<size_t>(std::countr_zero(NonAscii))};
+
+                for(size_t Byte{0}; Byte < NumAscii; ++Byte)
+                {
+                    EncodeAscii(Chunk[Index + Byte]);
+                }
+
+                Index += NumAscii;
+
+                if(NonAscii == 0)
+                {
+                    continue;
+                }
+            }
+            else if(static_cast<uint8>(Chunk[Index]) < 0x80)
+            {
+                EncodeAscii(Chunk[Index++]);
+                continue;
+            }
+
+            if(Index + Alphabet::GetSequenceLength(static_cast<uint8>(Chunk[Index])) > NumBytes && !bLastChunk)
+            {
+                break;
+            }
+
+            char32_t CodePoint{0};
+            const uint32 Length{Alphabet::DecodeUtf8(&Chunk[Index], NumBytes - Index, CodePoint)};
+
+            if unlikely(Length == 0)
+            {
+                ++Index;
+                continue;
+            }
+
+            const std::array<uint16, 2> PackedCodes{Alphabet.WideEncodeTable.Get(CodePoint)};
+
+            AppendCode(PackedCodes[0]);
+            AppendCode(PackedCodes[1]);
+
+            Index += Length;
+        }
+
+        NumCarried = NumBytes - Index;
+        std::memmove(Chunk.data(), Chunk.data() + Index, NumCarried);
+    }
+
+    FStream.close();
+
+    return MorseCodeVector;
+}
+
+std::vector<char> DecodeMorseToPlainText(const std::string& PathToFile, const FMorseAlphabet& Alphabet)
+{
+    std::vector<char> PlainTextVector{};
+    TContainerSink<std::vector<char>> Sink{PlainTextVector};
+    Morse::TDecodeCoder<FMorseAlphabetText> Coder{false, FMorseAlphabetText{&Alphabet}};
+
+    Sinks::CodeFile(PathToFile, Coder, Sink);
+
+    return PlainTextVector;
+}
@@ -0,0 +1,107 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "FileReader.h"
+#include <string_view>
+
+//the codes of the code points outside ASCII in pages of 256 code points, a page is only allocated once the alphabet has a code on it.
+//page 0 has no codes and every unused page points to it, so a lookup is two loads and no branch
+struct FMorseAlphabetWideTable
+{
+    static constexpr uint32 PageBits{8};
+    static constexpr size_t NumPageIndices{0x110000 >> PageBits};
+
+    using FPage = std::array<std::array<uint16, 2>, 1 << PageBits>;
+
+    std::array<uint16, NumPageIndices> PageIndices{};
+    std::vector<FPage> Pages{FPage{}};
+
+    //{0, 0} for a code point without a code, the code point has to be valid Unicode like DecodeUtf8 returns it
+    std::array<uint16, 2> Get(const char32_t CodePoint) const {return Pages[PageIndices[CodePoint >> PageBits]][CodePoint & ((1 << PageBits) - 1)];}
+
+    //allocates the page of the code point if it has none yet, which moves every other page
+    std::array<uint16, 2>& operator[](char32_t CodePoint);
+
+    bool operator==(const FMorseAlphabetWideTable& Other) const = default;
+};
+
+//a character set compiled into the same tables as the built-in one: a packed code per input byte and a text per packed code,
+//so encoding and decoding are one lookup whatever the alphabet. texts and characters outside ASCII are UTF-8
+struct FMorseAlphabet
+{
+    //0 for bytes without a code
+    std::array<uint16, 256> EncodeTable{};
+
+    //code points outside ASCII, a character can take two codes (Wabun kana with a voicing mark), the second is 0 otherwise
+    FMorseAlphabetWideTable WideEncodeTable{};
+
+    //index into Texts, 0 is Unrecognized
+    std::array<uint8, 2 << MorseCodes::MaxPackedElements> DecodeTable{};
+
+    std::vector<std::string> Texts{std::string{MorseCodes::Unrecognized}};
+
+    uint16 Encode(const char Character) const {return EncodeTable[static_cast<uint8>(Character)];}
+
+    std::string_view Decode(const uint16 PackedCode) const {return Texts[DecodeTable[PackedCode]];}
+
+    //MorseCodes::Alphabet and the prosigns, decodes like -Decode
+    static FMorseAlphabet BuiltIn();
+
+    //the national letters with the digits, punctuation and prosigns of the built-in alphabet, letters win where they share a code with punctuation
+    static FMorseAlphabet Cyrillic();
+    static FMorseAlphabet Greek();
+    static FMorseAlphabet Hebrew();
+    static FMorseAlphabet Arabic();
+
+    //katakana, hiragana is encoded as katakana and voiced kana as the plain kana followed by its voicing mark
+    static FMorseAlphabet Wabun();
+};
+
+//FMorseAlphabet::Decode as the lookup of Morse::TDecodeCoder, so a loaded alphabet decodes with the same kernel as -Decode
+struct FMorseAlphabetText
+{
+    const FMorseAlphabet* Alphabet{nullptr};
+
+    std::string_view operator()(const uint16 PackedCode) const {return Alphabet->Decode(PackedCode);}
+};
+
+//file layout: header, EncodeTable, DecodeTable, every text as a length byte and its bytes, then the page indices and pages of WideEncodeTable as they are in memory
+struct FMorseAlphabetCacheHeader
+{
+    std::array<char, 4> Magic{'M', 'A', 'L', '2'};
+    uint32 NumTexts{0};
+
+    //of the definition file the cache was compiled from, a cache that does not match is compiled again
+    uint64 SourceBytes{0};
+    int64 SourceWriteTime{0};
+
+    uint32 TextBytes{0};
+    uint32 NumWidePages{0};
+};
+
+static_assert(sizeof(FMorseAlphabetCacheHeader) == 32, "The header is written as it is laid out in memory");
+
+//one "<Character> <Pattern>" line per character, the character can be any UTF-8 character, the pattern written with . or * for short and - for long, lines starting with // are comments.
+//every conflict (a character or pattern defined twice, a bad pattern) is reported with its line and nothing is loaded.
+//the compiled tables are kept in <Path>.cache and read from there as long as the definition file is unchanged
+bool LoadMorseAlphabet(const std::string& PathToFile, FMorseAlphabet& OutAlphabet);
+
+//latin, cyrillic, greek, hebrew, arabic, wabun, or the path of a definition file for LoadMorseAlphabet
+bool ParseMorseAlphabet(std::string_view NameOrPath, FMorseAlphabet& OutAlphabet);
+
+//reads UTF-8, 32 bytes are checked for non-ASCII bytes at a time and all ASCII runs are encoded straight from EncodeTable,
+//only multi byte characters are decoded. characters without a code in the alphabet and invalid UTF-8 are left out
+std::vector<Simd::int16_8> EncodePlainTextToMorse(const std::string& PathToFile, const FMorseAlphabet& Alphabet);
+
+std::vector<char> DecodeMorseToPlainText(const std::string& PathToFile, const FMorseAlphabet& Alphabet);
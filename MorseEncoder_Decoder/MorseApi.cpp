@@ -0,0 +1,212 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "MorseApi.h"
+#include "MorseRanges.h"
+#include <cstring>
+#include <new>
+#include <variant>
+
+struct morse_stream
+{
+    std::variant<Morse::FEncodeCoder, Morse::FDecodeCoder> Coder;
+};
+
+namespace Api
+{
+    //the decoder strips blanks in place, so caller input is converted from a copy of each block
+    template<typename CoderType>
+    size_t ProcessBlock(CoderType& Coder, const char* Input, const size_t NumInput, const bool bLast, char* Output)
+    {
+        std::array<char, Morse::BlockBytes> Block{};
+
+        if(NumInput > 0)
+        {
+            std::memcpy(Block.data(), Input, NumInput);
+        }
+
+        return Coder.Process(Block.data(), NumInput, bLast, Output);
+    }
+
+    //a block is written straight into the output when its worst case fits, otherwise into a scratch block first.
+    //the coder is restored when a block does not fit, so the stream can go on from the first input byte not taken
+    template<typename CoderType>
+    morse_status Process(CoderType& Coder, const char* In, const size_t InLen, size_t& OutInUsed, char* Out, const size_t OutCap, size_t& OutLen, const bool bLast)
+    {
+        std::array<char, CoderType::MaxOutputBytes> Scratch{};
+
+        OutInUsed = 0;
+        OutLen = 0;
+
+        for(size_t Block{0}; Block < InLen || (bLast && Block == InLen); Block += Morse::BlockBytes)
+        {
+            const size_t NumInput{std::min(Morse::BlockBytes, InLen - Block)};
+            const bool bLastBlock{bLast && Block + NumInput == InLen};
+
+            if(OutCap - OutLen >= CoderType::MaxOutputBytes)
+            {
+                OutLen += ProcessBlock(Coder, In + Block, NumInput, bLastBlock, Out + OutLen);
+            }
+            else
+            {
+                const CoderType Saved{Coder};
+                const size_t NumOutput{ProcessBlock(Coder, In + Block, NumInput, bLastBlock, Scratch.data())};
+
+                if(NumOutput > OutCap - OutLen)
+                {
+                    Coder = Saved;
+                    return MORSE_ERROR_BUFFER_TOO_SMALL;
+                }
+
+                std::memcpy(Out + OutLen, Scratch.data(), NumOutput);
+                OutLen += NumOutput;
+            }
+
+            OutInUsed = Block + NumInput;
+
+            if(bLastBlock)
+            {
+                break;
+            }
+        }
+
+        return MORSE_OK;
+    }
+
+    //a message that does not fit is measured to the end so the caller can retry with the right size, what fit before is left in Out
+    template<typename CoderType>
+    morse_status Convert(const char* In, const size_t InLen, char* Out, const size_t OutCap, size_t* OutLen)
+    {
+        if((In == nullptr && InLen > 0) || (Out == nullptr && OutCap > 0) || OutLen == nullptr)
+        {
+            return MORSE_ERROR_INVALID_ARGUMENT;
+        }
+
+        CoderType Coder{};
+        size_t InUsed{0};
+
+        if(Process(Coder, In, InLen, InUsed, Out, OutCap, *OutLen, true) == MORSE_OK)
+        {
+            return MORSE_OK;
+        }
+
+        std::array<char, CoderType::MaxOutputBytes> Scratch{};
+
+        for(size_t Block{InUsed}; Block <= InLen; Block += Morse::BlockBytes)
+        {
+            const size_t NumInput{std::min(Morse::BlockBytes, InLen - Block)};
+
+            *OutLen += ProcessBlock(Coder, In + Block, NumInput, Block + NumInput == InLen, Scratch.data());
+
+            if(Block + NumInput == InLen)
+            {
+                break;
+            }
+        }
+
+        return MORSE_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    size_t GetBound(const size_t InLen, const size_t MaxOutputBytes)
+    {
+        return (InLen / Morse::BlockBytes + 1) * MaxOutputBytes;
+    }
+}
+
+int morse_api_version(void)
+{
+    return MORSE_API_VERSION;
+}
+
+void morse_init(void)
+{
+    //the tables are function statics, which C++ builds once even when threads race for them
+    std::array<char, Morse::BlockBytes> Text{'S', 'O', 'S', ' ', '<', 'A', 'R', '>'};
+    std::array<char, Morse::FEncodeCoder::MaxOutputBytes> Code{};
+    std::array<char, Morse::FDecodeCoder::MaxOutputBytes> Decoded{};
+
+    Morse::FEncodeCoder Encoder{};
+    const size_t NumMorse{Encoder.Process(Text.data(), 8, true, Code.data())};
+
+    Morse::FDecodeCoder Decoder{};
+    Decoder.Process(Code.data(), std::min(NumMorse, Morse::BlockBytes), true, Decoded.data());
+}
+
+size_t morse_encode_bound(const size_t in_len)
+{
+    return Api::GetBound(in_len, Morse::FEncodeCoder::MaxOutputBytes);
+}
+
+size_t morse_decode_bound(const size_t in_len)
+{
+    return Api::GetBound(in_len, Morse::FDecodeCoder::MaxOutputBytes);
+}
+
+morse_status morse_encode(const char* in, const size_t in_len, char* out, const size_t out_cap, size_t* out_len)
+{
+    return Api::Convert<Morse::FEncodeCoder>(in, in_len, out, out_cap, out_len);
+}
+
+morse_status morse_decode(const char* in, const size_t in_len, char* out, const size_t out_cap, size_t* out_len)
+{
+    return Api::Convert<Morse::FDecodeCoder>(in, in_len, out, out_cap, out_len);
+}
+
+morse_stream* morse_encoder_create(void)
+{
+    return new(std::nothrow) morse_stream{Morse::FEncodeCoder{}};
+}
+
+morse_stream* morse_decoder_create(void)
+{
+    return new(std::nothrow) morse_stream{Morse::FDecodeCoder{}};
+}
+
+void morse_stream_destroy(morse_stream* stream)
+{
+    delete stream;
+}
+
+morse_status morse_stream_process(morse_stream* stream, const char* in, const size_t in_len, size_t* in_used, char* out, const size_t out_cap, size_t* out_len)
+{
+    if(stream == nullptr || (in == nullptr && in_len > 0) || (out == nullptr && out_cap > 0) || in_used == nullptr || out_len == nullptr)
+    {
+        return MORSE_ERROR_INVALID_ARGUMENT;
+    }
+
+    const morse_status Status{std::visit([&](auto& Coder) -> morse_status {return Api::Process(Coder, in, in_len, *in_used, out, out_cap, *out_len, false);}, stream->Coder)};
+
+    //running out of room part way is normal for a stream, the caller passes the rest again
+    return Status == MORSE_ERROR_BUFFER_TOO_SMALL && *in_used > 0 ? MORSE_OK : Status;
+}
+
+morse_status morse_stream_finish(morse_stream* stream, char* out, const size_t out_cap, size_t* out_len)
+{
+    if(stream == nullptr || (out == nullptr && out_cap > 0) || out_len == nullptr)
+    {
+        return MORSE_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t InUsed{0};
+
+    return std::visit([&](auto& Coder) -> morse_status
+    {
+        const morse_status Status{Api::Process(Coder, nullptr, 0, InUsed, out, out_cap, *out_len, true)};
+
+        if(Status == MORSE_OK)
+        {
+            Coder = std::remove_reference_t<decltype(Coder)>{};
+        }
+
+        return Status;
+    }, stream->Coder);
+}
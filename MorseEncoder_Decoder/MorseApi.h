@@ -0,0 +1,82 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+//plain C interface for other languages, every function works on caller owned memory so nothing is copied across the boundary
+//and nothing has to be freed by the caller except streams. the names are the exported symbols and stay as they are
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+    #if defined(MORSE_BUILD_LIBRARY)
+        #define MORSE_API __declspec(dllexport)
+    #else
+        #define MORSE_API __declspec(dllimport)
+    #endif
+#else
+    #define MORSE_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//raised when a function changes in a way existing callers would notice
+#define MORSE_API_VERSION 1
+
+typedef enum morse_status
+{
+    MORSE_OK = 0,
+    MORSE_ERROR_INVALID_ARGUMENT = 1,
+
+    //out_cap is too small, the function says what out and out_len hold then
+    MORSE_ERROR_BUFFER_TOO_SMALL = 2,
+
+    MORSE_ERROR_OUT_OF_MEMORY = 3
+} morse_status;
+
+typedef struct morse_stream morse_stream;
+
+MORSE_API int morse_api_version(void);
+
+//builds the lookup tables, safe to call from any number of threads at once and more than once.
+//everything works without it, it only keeps the first call of a service from paying for the tables
+MORSE_API void morse_init(void);
+
+//the most output in_len bytes of input can produce, a buffer this big never fails with MORSE_ERROR_BUFFER_TOO_SMALL
+MORSE_API size_t morse_encode_bound(size_t in_len);
+MORSE_API size_t morse_decode_bound(size_t in_len);
+
+//plain text to native morse-code byte for byte like -Encode, and back like -Decode with # for unrecognized codes.
+//on MORSE_ERROR_BUFFER_TOO_SMALL out_len holds the bytes the whole output needs and out the part of it that fit, which is not a message of its own
+MORSE_API morse_status morse_encode(const char* in, size_t in_len, char* out, size_t out_cap, size_t* out_len);
+MORSE_API morse_status morse_decode(const char* in, size_t in_len, char* out, size_t out_cap, size_t* out_len);
+
+//streams keep the state between pieces of input, so a message can arrive in pieces of any size.
+//a stream is used by one thread at a time, different streams can be used by different threads. NULL if out of memory
+MORSE_API morse_stream* morse_encoder_create(void);
+MORSE_API morse_stream* morse_decoder_create(void);
+MORSE_API void morse_stream_destroy(morse_stream* stream);
+
+//converts as much of in as fits in out, in_used tells how much of it was taken, the rest has to be passed again.
+//MORSE_ERROR_BUFFER_TOO_SMALL only when not even the first block of in fits, then nothing is taken or written. morse_encode_bound(32) bytes always fit
+MORSE_API morse_status morse_stream_process(morse_stream* stream, const char* in, size_t in_len, size_t* in_used, char* out, size_t out_cap, size_t* out_len);
+
+//writes what the stream held back for the end of the message and resets it for the next one.
+//on MORSE_ERROR_BUFFER_TOO_SMALL nothing is written and the stream is kept, so it can be finished again with more room
+MORSE_API morse_status morse_stream_finish(morse_stream* stream, char* out, size_t out_cap, size_t* out_len);
+
+#ifdef __cplusplus
+}
+#endif
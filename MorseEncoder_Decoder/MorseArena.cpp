@@ -0,0 +1,25 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "MorseArena.h"
+
+FMorseArena::FMorseArena(const size_t InitialBytes)
+    : InitialBlock(std::make_unique_for_overwrite<std::byte[]>(InitialBytes))
+    , Resource(InitialBlock.get(), InitialBytes, std::pmr::new_delete_resource())
+{
+}
+
+void FMorseArena::Reset()
+{
+    //blocks that came from the global heap are freed, the next allocation starts at the front of the first block again
+    Resource.release();
+}
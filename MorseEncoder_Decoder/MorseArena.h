@@ -0,0 +1,42 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "FileReader.h"
+#include <memory>
+#include <memory_resource>
+
+//a monotonic arena for one request: allocating bumps a pointer, freeing does nothing and Reset gives everything back at once.
+//the first block is kept across resets, requests that fit in it never reach the global heap.
+//only the pmr overloads of DecodeMorseToPlainText and EncodePlainTextToMorse allocate from it, their results and their read and output buffers.
+//dialects, custom alphabets, search, ranges and the word index keep their scratch on the global heap
+class FMorseArena final
+{
+public:
+
+    //the default fits the read and output buffers and a few MiB of results
+    explicit FMorseArena(size_t InitialBytes = 8 << 20);
+
+    FMorseArena(const FMorseArena&) = delete;
+    FMorseArena& operator=(const FMorseArena&) = delete;
+
+    std::pmr::memory_resource* GetResource() {return &Resource;}
+
+    //every vector allocated from the arena has to be gone before this
+    void Reset();
+
+private:
+
+    std::unique_ptr<std::byte[]> InitialBlock;
+    std::pmr::monotonic_buffer_resource Resource;
+};
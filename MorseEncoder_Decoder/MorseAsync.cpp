@@ -0,0 +1,94 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "MorseAsync.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Async
+{
+    constexpr size_t ReadChunkBytes{1 << 16};
+}
+
+void Morse::FMorseStream::Push(const std::string_view Bytes)
+{
+    Pending.append(Bytes);
+    ResumeReader();
+}
+
+void Morse::FMorseStream::Close()
+{
+    bClosed = true;
+    ResumeReader();
+}
+
+size_t Morse::FMorseStream::Take(const std::span<char> Buffer)
+{
+    const size_t NumBytes{std::min(Buffer.size(), Pending.size() - ReadOffset)};
+
+    std::memcpy(Buffer.data(), Pending.data() + ReadOffset, NumBytes);
+    ReadOffset += NumBytes;
+
+    if(ReadOffset == Pending.size())
+    {
+        Pending.clear();
+        ReadOffset = 0;
+    }
+
+    return NumBytes;
+}
+
+void Morse::FMorseStream::ResumeReader()
+{
+    //the reader may suspend on this stream again while it runs
+    if(const std::coroutine_handle<> Handle{std::exchange(Reader, nullptr)})
+    {
+        Handle.resume();
+    }
+}
+
+Morse::TMorseGenerator<std::string_view> Morse::DecodeChunks(const std::string PathToFile)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, std::ios::in | std::ios::binary);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        co_return;
+    }
+
+    FDecodeCoder Coder{};
+
+    std::vector<char> Chunk(Async::ReadChunkBytes);
+    std::vector<char> Output(Async::ReadChunkBytes / BlockBytes * FDecodeCoder::MaxOutputBytes);
+
+    while(FStream.read(Chunk.data(), static_cast<std::streamsize>(Chunk.size())) || FStream.gcount() > 0)
+    {
+        const size_t NumRead{static_cast<size_t>(FStream.gcount())};
+
+        size_t NumOutput{0};
+
+        for(size_t Block{0}; Block < NumRead; Block += BlockBytes)
+        {
+            NumOutput += Coder.Process(&Chunk[Block], std::min(BlockBytes, NumRead - Block), false, &Output[NumOutput]);
+        }
+
+        if(NumOutput > 0)
+        {
+            co_yield std::string_view{Output.data(), NumOutput};
+        }
+    }
+
+    FStream.close();
+}
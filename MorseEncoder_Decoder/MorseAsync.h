@@ -0,0 +1,312 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "MorseRanges.h"
+#include <coroutine>
+#include <exception>
+#include <span>
+#include <utility>
+
+namespace Morse
+{
+    //bytes taken from a source per step, every step ends with one write to the sink
+    inline constexpr size_t AsyncChunkBytes{1 << 12};
+
+    //Read fills the front of the buffer and resumes with the number of bytes, 0 once the source is exhausted
+    template<typename SourceType>
+    concept CMorseSource = requires(SourceType& Source, std::span<char> Buffer)
+    {
+        {Source.Read(Buffer).await_resume()} -> std::convertible_to<size_t>;
+    };
+
+    //Write may suspend until the text is taken, the text is only valid until it resumes
+    template<typename SinkType>
+    concept CMorseSink = requires(SinkType& Sink, std::string_view Text)
+    {
+        Sink.Write(Text).await_resume();
+    };
+
+    //a lazily started coroutine, either co_awaited by another one or started by an event loop that checks IsDone.
+    //the awaiting coroutine is resumed by symmetric transfer, so long chains of tasks do not grow the stack
+    class FMorseTask final
+    {
+    public:
+
+        struct promise_type
+        {
+            std::coroutine_handle<> Continuation{std::noop_coroutine()};
+
+            FMorseTask get_return_object() {return FMorseTask{std::coroutine_handle<promise_type>::from_promise(*this)};}
+
+            std::suspend_always initial_suspend() noexcept {return {};}
+
+            auto final_suspend() noexcept
+            {
+                struct FFinalAwaitable
+                {
+                    bool await_ready() noexcept {return false;}
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> Handle) noexcept {return Handle.promise().Continuation;}
+                    void await_resume() noexcept {}
+                };
+
+                return FFinalAwaitable{};
+            }
+
+            void return_void() {}
+
+            //nothing in here throws on purpose, an allocation failure is as fatal as it is elsewhere
+            void unhandled_exception() {std::terminate();}
+        };
+
+        FMorseTask(FMorseTask&& Other) noexcept
+            : Handle(std::exchange(Other.Handle, nullptr))
+        {
+        }
+
+        FMorseTask& operator=(FMorseTask&& Other) noexcept
+        {
+            if(this != &Other)
+            {
+                Destroy();
+                Handle = std::exchange(Other.Handle, nullptr);
+            }
+
+            return *this;
+        }
+
+        ~FMorseTask() {Destroy();}
+
+        bool await_ready() const noexcept {return false;}
+
+        std::coroutine_handle<> await_suspend(const std::coroutine_handle<> Awaiting) noexcept
+        {
+            Handle.promise().Continuation = Awaiting;
+            return Handle;
+        }
+
+        void await_resume() const noexcept {}
+
+        //runs until the first suspension, a source or sink that is not ready resumes the rest later
+        void Start() {Handle.resume();}
+
+        bool IsDone() const {return Handle.done();}
+
+    private:
+
+        explicit FMorseTask(const std::coroutine_handle<promise_type> InHandle)
+            : Handle(InHandle)
+        {
+        }
+
+        void Destroy()
+        {
+            if(Handle)
+            {
+                Handle.destroy();
+            }
+        }
+
+        std::coroutine_handle<promise_type> Handle{};
+    };
+
+    //a coroutine that yields values one at a time, for range-for
+    template<typename ValueType>
+    class TMorseGenerator final
+    {
+    public:
+
+        struct promise_type
+        {
+            ValueType Current{};
+
+            TMorseGenerator get_return_object() {return TMorseGenerator{std::coroutine_handle<promise_type>::from_promise(*this)};}
+
+            std::suspend_always initial_suspend() noexcept {return {};}
+            std::suspend_always final_suspend() noexcept {return {};}
+
+            std::suspend_always yield_value(ValueType Value)
+            {
+                Current = std::move(Value);
+                return {};
+            }
+
+            void return_void() {}
+            void unhandled_exception() {std::terminate();}
+        };
+
+        class FIterator
+        {
+        public:
+
+            using value_type = ValueType;
+            using difference_type = std::ptrdiff_t;
+
+            FIterator() = default;
+
+            explicit FIterator(const std::coroutine_handle<promise_type> InHandle)
+                : Handle(InHandle)
+            {
+            }
+
+            const ValueType& operator*() const {return Handle.promise().Current;}
+
+            FIterator& operator++()
+            {
+                Handle.resume();
+                return *this;
+            }
+
+            void operator++(int) {++*this;}
+
+            friend bool operator==(const FIterator& Iterator, std::default_sentinel_t) {return Iterator.Handle.done();}
+
+        private:
+
+            std::coroutine_handle<promise_type> Handle{};
+        };
+
+        TMorseGenerator(TMorseGenerator&& Other) noexcept
+            : Handle(std::exchange(Other.Handle, nullptr))
+        {
+        }
+
+        TMorseGenerator& operator=(TMorseGenerator&&) = delete;
+
+        ~TMorseGenerator()
+        {
+            if(Handle)
+            {
+                Handle.destroy();
+            }
+        }
+
+        FIterator begin()
+        {
+            Handle.resume();
+            return FIterator{Handle};
+        }
+
+        std::default_sentinel_t end() const {return std::default_sentinel;}
+
+    private:
+
+        explicit TMorseGenerator(const std::coroutine_handle<promise_type> InHandle)
+            : Handle(InHandle)
+        {
+        }
+
+        std::coroutine_handle<promise_type> Handle{};
+    };
+
+    //a source fed from outside, for example by the read callback of a socket. Push and Close resume a waiting reader on the calling thread,
+    //so a stream has to be used from one thread at a time, different streams can run on different threads
+    class FMorseStream final
+    {
+    public:
+
+        void Push(std::string_view Bytes);
+
+        //the reader gets 0 once everything pushed before is read
+        void Close();
+
+        auto Read(const std::span<char> Buffer)
+        {
+            struct FReadAwaitable
+            {
+                FMorseStream& Stream;
+                std::span<char> Buffer;
+
+                bool await_ready() const noexcept {return Stream.Pending.size() > Stream.ReadOffset || Stream.bClosed;}
+                void await_suspend(const std::coroutine_handle<> Handle) noexcept {Stream.Reader = Handle;}
+                size_t await_resume() {return Stream.Take(Buffer);}
+            };
+
+            return FReadAwaitable{*this, Buffer};
+        }
+
+    private:
+
+        size_t Take(std::span<char> Buffer);
+        void ResumeReader();
+
+        std::string Pending{};
+
+        //bytes of Pending in front of this were read already, they are dropped once everything is read
+        size_t ReadOffset{0};
+
+        std::coroutine_handle<> Reader{};
+        bool bClosed{false};
+    };
+
+    //collects everything written, never suspends
+    struct FStringSink
+    {
+        std::string Text{};
+
+        std::suspend_never Write(const std::string_view Bytes)
+        {
+            Text.append(Bytes);
+            return {};
+        }
+    };
+
+    template<typename CoderType, CMorseSource SourceType, CMorseSink SinkType>
+    FMorseTask TranscodeAsync(SourceType& Source, SinkType& Sink)
+    {
+        CoderType Coder{};
+
+        std::array<char, AsyncChunkBytes> Input{};
+        std::vector<char> Output(AsyncChunkBytes / BlockBytes * CoderType::MaxOutputBytes + CoderType::MaxOutputBytes);
+
+        for(bool bLast{false}; !bLast;)
+        {
+            const size_t NumRead{co_await Source.Read(std::span<char>{Input})};
+            bLast = NumRead == 0;
+
+            size_t NumOutput{0};
+
+            for(size_t Block{0}; Block < NumRead; Block += BlockBytes)
+            {
+                NumOutput += Coder.Process(&Input[Block], std::min(BlockBytes, NumRead - Block), false, &Output[NumOutput]);
+            }
+
+            if(bLast)
+            {
+                NumOutput += Coder.Process(Input.data(), 0, true, &Output[NumOutput]);
+            }
+
+            //yields to the loop at every buffer boundary through the source, a slow sink holds the stream back here
+            if(NumOutput > 0)
+            {
+                co_await Sink.Write(std::string_view{Output.data(), NumOutput});
+            }
+        }
+    }
+
+    //co_await Morse::EncodeAsync(Source, Sink), or keep the task and Start it from an event loop
+    template<CMorseSource SourceType, CMorseSink SinkType>
+    FMorseTask EncodeAsync(SourceType& Source, SinkType& Sink)
+    {
+        return TranscodeAsync<FEncodeCoder>(Source, Sink);
+    }
+
+    template<CMorseSource SourceType, CMorseSink SinkType>
+    FMorseTask DecodeAsync(SourceType& Source, SinkType& Sink)
+    {
+        return TranscodeAsync<FDecodeCoder>(Source, Sink);
+    }
+
+    //decodes a morse-code file a chunk at a time, each chunk is valid until the next one is asked for
+    TMorseGenerator<std::string_view> DecodeChunks(std::string PathToFile);
+}
@@ -0,0 +1,358 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "MorseNotation.h"
+#include "MorseSink.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <numeric>
+
+namespace Dialect
+{
+    constexpr size_t ReadChunkBytes{1 << 20};
+    constexpr size_t MaxTokenLength{8};
+
+    //zeros behind the pending bytes, so the shifted loads of the last register never leave the buffer
+    constexpr size_t Padding{32 + MaxTokenLength};
+
+    std::array<std::string, 4> GetTokens(const FMorseNotation& Notation)
+    {
+        return std::array<std::string, 4>{Notation.Short, Notation.Long, Notation.SeparateChar, Notation.NewWord};
+    }
+
+    //native text through the decode kernel a block at a time, NativeText is used up
+    void DecodeNativeText(Morse::FDecodeCoder& Coder, std::vector<char>& NativeText, std::vector<char>& OutPlainText)
+    {
+        std::array<char, Morse::FDecodeCoder::MaxOutputBytes> Output;
+
+        for(size_t Block{0}; Block < NativeText.size(); Block += Morse::BlockBytes)
+        {
+            const size_t NumOutput{Coder.Process(&NativeText[Block], std::min(Morse::BlockBytes, NativeText.size() - Block), false, Output.data())};
+
+            OutPlainText.insert(OutPlainText.end(), Output.data(), Output.data() + NumOutput);
+        }
+
+        NativeText.clear();
+    }
+
+    //decodes the code the kernel holds as if a separator followed it, nothing if it holds none
+    void EndCharacter(Morse::FDecodeCoder& Coder, std::vector<char>& OutPlainText)
+    {
+        if(Coder.PackedCode != 1)
+        {
+            std::vector<char> Separator{static_cast<char>(MorseCodes::SeparateChar)};
+            DecodeNativeText(Coder, Separator, OutPlainText);
+        }
+    }
+
+    void WriteBytes(const std::string& PathToOutFile, const std::vector<char>& BytesToWrite)
+    {
+        std::fstream FStream{};
+
+        FStream.open(PathToOutFile, std::ios::out | std::ios::binary);
+
+        if(!FStream)
+        {
+            std::cerr << "Failed to open file with path: " << PathToOutFile << std::endl;
+            return;
+        }
+
+        FStream.write(BytesToWrite.data(), static_cast<std::streamsize>(BytesToWrite.size()));
+
+        FStream.close();
+    }
+}
+
+bool FMorseNotation::IsNative() const
+{
+    const FMorseNotation NativeNotation{Native()};
+
+    return Short == NativeNotation.Short && Long == NativeNotation.Long && SeparateChar == NativeNotation.SeparateChar && NewWord == NativeNotation.NewWord;
+}
+
+bool ParseMorseNotation(const std::string_view Name, FMorseNotation& OutNotation)
+{
+    if(Name == "native")
+    {
+        OutNotation = FMorseNotation::Native();
+        return true;
+    }
+    if(Name == "dots")
+    {
+        OutNotation = FMorseNotation::Dots();
+        return true;
+    }
+    if(Name == "unicode")
+    {
+        OutNotation = FMorseNotation::Unicode();
+        return true;
+    }
+
+    std::array<std::string, 4> Tokens{};
+    size_t NumTokens{0};
+
+    for(size_t Start{0}; Start <= Name.size() && NumTokens < Tokens.size(); ++NumTokens)
+    {
+        const size_t End{std::min(Name.find(',', Start), Name.size())};
+
+        Tokens[NumTokens] = std::string{Name.substr(Start, End - Start)};
+        Start = End + 1;
+    }
+
+    const bool bValidTokens{std::all_of(Tokens.begin(), Tokens.end(), [](const std::string& Token) -> bool {return !Token.empty() && Token.size() <= Dialect::MaxTokenLength;})};
+
+    std::array<std::string, 4> SortedTokens{Tokens};
+    std::sort(SortedTokens.begin(), SortedTokens.end());
+
+    if(NumTokens != Tokens.size() || !bValidTokens || std::adjacent_find(SortedTokens.begin(), SortedTokens.end()) != SortedTokens.end())
+    {
+        std::cerr << "Unknown notation: " << Name << std::endl;
+        return false;
+    }
+
+    OutNotation = FMorseNotation{Tokens[0], Tokens[1], Tokens[2], Tokens[3]};
+    return true;
+}
+
+FMorseTranscoder::FMorseTranscoder(const FMorseNotation& From, const FMorseNotation& To)
+{
+    const std::array<std::string, 4> SourceTokens{Dialect::GetTokens(From)};
+    const std::array<std::string, 4> TargetTokens{Dialect::GetTokens(To)};
+
+    std::array<size_t, 4> Order{};
+    std::iota(Order.begin(), Order.end(), 0);
+    std::stable_sort(Order.begin(), Order.end(), [&SourceTokens](const size_t A, const size_t B) -> bool {return SourceTokens[A].size() > SourceTokens[B].size();});
+
+    for(size_t Token{0}; Token < Order.size(); ++Token)
+    {
+        FromTokens[Token] = SourceTokens[Order[Token]];
+        ToTokens[Token] = TargetTokens[Order[Token]];
+
+        checkf(!FromTokens[Token].empty() && FromTokens[Token].size() <= Dialect::MaxTokenLength, "Tokens have to be 1 to 8 bytes long")
+
+        MaxTokenLength = std::max(MaxTokenLength, FromTokens[Token].size());
+        bSingleBytes &= FromTokens[Token].size() == 1 && ToTokens[Token].size() == 1;
+    }
+}
+
+void FMorseTranscoder::Push(const char* Text, const size_t NumBytes, std::vector<char>& OutText)
+{
+    Pending.insert(Pending.end(), Text, Text + NumBytes);
+
+    if(Pending.size() >= MaxTokenLength)
+    {
+        Translate(Pending.size() - (MaxTokenLength - 1), OutText);
+    }
+}
+
+void FMorseTranscoder::Finish(std::vector<char>& OutText)
+{
+    Translate(Pending.size(), OutText);
+
+    Pending.clear();
+    NextFree = 0;
+}
+
+void FMorseTranscoder::Translate(const size_t End, std::vector<char>& OutText)
+{
+    const size_t NumPending{Pending.size()};
+    Pending.resize(NumPending + Dialect::Padding, 0);
+
+    for(size_t Block{0}; Block < End; Block += 32)
+    {
+        const uint32 InRange{End - Block >= 32 ? ~0u : (1u << (End - Block)) - 1};
+
+        if(bSingleBytes)
+        {
+            const __m256i Bytes{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Pending[Block]))};
+
+            __m256i Translated{_mm256_setzero_si256()};
+            __m256i Matched{_mm256_setzero_si256()};
+
+            for(size_t Token{0}; Token < FromTokens.size(); ++Token)
+            {
+                const __m256i Match{_mm256_cmpeq_epi8(Bytes, _mm256_set1_epi8(FromTokens[Token][0]))};
+
+                Translated = _mm256_blendv_epi8(Translated, _mm256_set1_epi8(ToTokens[Token][0]), Match);
+                Matched = _mm256_or_si256(Matched, Match);
+            }
+
+            const uint32 Valid{static_cast<uint32>(_mm256_movemask_epi8(Matched)) & InRange};
+
+            alignas(32) std::array<char, 32> TranslatedBytes{};
+            _mm256_store_si256(reinterpret_cast<__m256i*>(TranslatedBytes.data()), Translated);
+
+            //clean morse-code is all symbols, so whole registers are the common case
+            if likely(Valid == ~0u)
+            {
+                OutText.insert(OutText.end(), TranslatedBytes.begin(), TranslatedBytes.end());
+            }
+            else
+            {
+                for(uint32 Bits{Valid}; Bits != 0; Bits &= Bits - 1)
+                {
+                    OutText.emplace_back(TranslatedBytes[std::countr_zero(Bits)]);
+                }
+            }
+        }
+        else
+        {
+            std::array<uint32, 4> Starts{};
+            uint32 AnyStart{0};
+
+            //a token starts where each of its bytes matches the register shifted by its position
+            for(size_t Token{0}; Token < FromTokens.size(); ++Token)
+            {
+                Starts[Token] = InRange;
+
+                for(size_t Byte{0}; Byte < FromTokens[Token].size(); ++Byte)
+                {
+                    const __m256i Bytes{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Pending[Block + Byte]))};
+
+                    Starts[Token] &= static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(Bytes, _mm256_set1_epi8(FromTokens[Token][Byte]))));
+                }
+
+                AnyStart |= Starts[Token];
+            }
+
+            for(; AnyStart != 0; AnyStart &= AnyStart - 1)
+            {
+                const uint32 Bit{static_cast<uint32>(std::countr_zero(AnyStart))};
+
+                if(Block + Bit < NextFree)
+                {
+                    continue;
+                }
+
+                for(size_t Token{0}; Token < FromTokens.size(); ++Token)
+                {
+                    if((Starts[Token] >> Bit) & 1)
+                    {
+                        OutText.insert(OutText.end(), ToTokens[Token].begin(), ToTokens[Token].end());
+                        NextFree = Block + Bit + FromTokens[Token].size();
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    Pending.resize(NumPending);
+    Pending.erase(Pending.begin(), Pending.begin() + static_cast<std::ptrdiff_t>(End));
+
+    NextFree = NextFree > End ? NextFree - End : 0;
+}
+
+std::vector<char> TranscodeMorseFile(const std::string& PathToFile, const FMorseNotation& From, const FMorseNotation& To)
+{
+    std::vector<char> MorseTextVector{};
+
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, std::ios::in | std::ios::binary);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return MorseTextVector;
+    }
+
+    FMorseTranscoder Transcoder{From, To};
+    std::vector<char> Chunk(Dialect::ReadChunkBytes);
+
+    while(FStream.read(Chunk.data(), static_cast<std::streamsize>(Chunk.size())) || FStream.gcount() > 0)
+    {
+        Transcoder.Push(Chunk.data(), static_cast<size_t>(FStream.gcount()), MorseTextVector);
+    }
+
+    Transcoder.Finish(MorseTextVector);
+
+    FStream.close();
+
+    return MorseTextVector;
+}
+
+std::vector<char> DecodeMorseToPlainText(const std::string& PathToFile, const FMorseNotation& Notation, const bool bRepairUnrecognized)
+{
+    if(Notation.IsNative())
+    {
+        return DecodeMorseToPlainText(PathToFile, bRepairUnrecognized);
+    }
+
+    std::vector<char> PlainTextVector{};
+
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, std::ios::in | std::ios::binary);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return PlainTextVector;
+    }
+
+    FMorseTranscoder Transcoder{Notation, FMorseNotation::Native()};
+    Morse::FDecodeCoder Coder{bRepairUnrecognized};
+
+    std::vector<char> Chunk(Dialect::ReadChunkBytes);
+    std::vector<char> NativeText{};
+
+    //a dialect that has no line break in its tokens ends a character at the end of a line, so wrapped text decodes like one long line
+    const std::array<std::string, 4> Tokens{Dialect::GetTokens(Notation)};
+    const bool bLineBreakSeparates{std::none_of(Tokens.begin(), Tokens.end(), [](const std::string& Token) -> bool {return Token.find('\n') != std::string::npos;})};
+
+    while(FStream.read(Chunk.data(), static_cast<std::streamsize>(Chunk.size())) || FStream.gcount() > 0)
+    {
+        const char* Line{Chunk.data()};
+        const char* const End{Chunk.data() + FStream.gcount()};
+
+        for(const char* Break{nullptr}; bLineBreakSeparates && (Break = static_cast<const char*>(std::memchr(Line, '\n', static_cast<size_t>(End - Line)))) != nullptr; Line = Break + 1)
+        {
+            //no token goes on past a line break
+            Transcoder.Push(Line, static_cast<size_t>(Break - Line), NativeText);
+            Transcoder.Finish(NativeText);
+
+            Dialect::DecodeNativeText(Coder, NativeText, PlainTextVector);
+            Dialect::EndCharacter(Coder, PlainTextVector);
+        }
+
+        Transcoder.Push(Line, static_cast<size_t>(End - Line), NativeText);
+        Dialect::DecodeNativeText(Coder, NativeText, PlainTextVector);
+    }
+
+    Transcoder.Finish(NativeText);
+
+    //the last character needs no separator after it either
+    Dialect::DecodeNativeText(Coder, NativeText, PlainTextVector);
+    Dialect::EndCharacter(Coder, PlainTextVector);
+
+    FStream.close();
+
+    return PlainTextVector;
+}
+
+void WriteToFile(const std::string& PathToOutFile, const std::vector<Simd::int16_8>& StringToWrite, const FMorseNotation& Notation)
+{
+    std::vector<char> NativeText{};
+
+    TContainerSink<std::vector<char>> Sink{NativeText};
+    WriteValidElements(StringToWrite, Sink);
+
+    std::vector<char> MorseTextVector{};
+
+    FMorseTranscoder Transcoder{FMorseNotation::Native(), Notation};
+    Transcoder.Push(NativeText.data(), NativeText.size(), MorseTextVector);
+    Transcoder.Finish(MorseTextVector);
+
+    Dialect::WriteBytes(PathToOutFile, MorseTextVector);
+}
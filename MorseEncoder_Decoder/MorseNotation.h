@@ -0,0 +1,79 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "FileReader.h"
+#include <string_view>
+
+//the byte sequences a dialect writes for each morse symbol, tokens can be several bytes long (UTF-8, " / ")
+struct FMorseNotation
+{
+    std::string Short{"*"};
+    std::string Long{"-"};
+    std::string SeparateChar{"&"};
+    std::string NewWord{"|"};
+
+    static FMorseNotation Native() {return FMorseNotation{};}
+
+    //.... . .-.. .-.. --- / .-- --- .-. .-.. -..
+    static FMorseNotation Dots() {return FMorseNotation{".", "-", " ", " / "};}
+
+    //U+00B7 middle dot and U+2212 minus sign
+    static FMorseNotation Unicode() {return FMorseNotation{"\xC2\xB7", "\xE2\x88\x92", " ", " / "};}
+
+    bool IsNative() const;
+};
+
+//"native", "dots", "unicode" or the four tokens separated by commas in the order short, long, new character, new word.
+//tokens have to be distinct, non-empty and at most 8 bytes long
+bool ParseMorseNotation(std::string_view Name, FMorseNotation& OutNotation);
+
+//translates one dialect into another, bytes that are not part of a token are dropped.
+//single byte dialects are translated 32 bytes at a time with compares and blends, multi byte tokens are matched with shifted compares
+//and the longest token wins where several start at the same byte
+class FMorseTranscoder final
+{
+public:
+
+    FMorseTranscoder(const FMorseNotation& From, const FMorseNotation& To);
+
+    //the last bytes that could still begin a token wait for the next call
+    void Push(const char* Text, size_t NumBytes, std::vector<char>& OutText);
+
+    void Finish(std::vector<char>& OutText);
+
+private:
+
+    void Translate(size_t End, std::vector<char>& OutText);
+
+    //sorted by the length of the source token, longest first
+    std::array<std::string, 4> FromTokens{};
+    std::array<std::string, 4> ToTokens{};
+
+    size_t MaxTokenLength{1};
+    bool bSingleBytes{true};
+
+    std::vector<char> Pending{};
+
+    //bytes of Pending in front of this still belong to the last translated token
+    size_t NextFree{0};
+};
+
+std::vector<char> TranscodeMorseFile(const std::string& PathToFile, const FMorseNotation& From, const FMorseNotation& To);
+
+//reads any dialect directly, the text is translated chunk by chunk and decoded with the -Decode kernel.
+//outside the native dialect the end of a line and the end of the file also end a character, as dotted text is usually written
+std::vector<char> DecodeMorseToPlainText(const std::string& PathToFile, const FMorseNotation& Notation, bool bRepairUnrecognized = false);
+
+//writes encoded morse-code in the given dialect
+void WriteToFile(const std::string& PathToOutFile, const std::vector<Simd::int16_8>& StringToWrite, const FMorseNotation& Notation);
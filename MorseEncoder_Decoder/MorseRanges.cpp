@@ -0,0 +1,110 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "MorseRanges.h"
+#include <algorithm>
+#include <bit>
+
+namespace Ranges
+{
+    uint16 GetPackedMorseFromCharacter(const char Character)
+    {
+        static const std::array<uint16, 256> EncodeTable{[]() -> std::array<uint16, 256>
+        {
+            std::array<uint16, 256> Table{};
+
+            for(size_t Index{0}; Index < Table.size(); ++Index)
+            {
+                //the empty code packs to the bare sentinel and has no elements, the word space is handled before a lookup
+                Table[Index] = PackMorseCode(GetMorseFromCharacter(static_cast<char>(Index)));
+            }
+
+            return Table;
+        }()};
+
+        return EncodeTable[static_cast<uint8>(Character)];
+    }
+}
+
+size_t Morse::FEncodeCoder::Process(char* Input, const size_t NumInput, const bool bLast, char* Output)
+{
+    //the start of a prosign held back from the last block goes in front of this one
+    std::array<char, MaxHeldBytes + BlockBytes> Text;
+
+    std::copy_n(Held.begin(), NumHeld, Text.begin());
+    std::copy_n(Input, NumInput, Text.begin() + static_cast<std::ptrdiff_t>(NumHeld));
+
+    const size_t NumText{NumHeld + NumInput};
+    NumHeld = 0;
+
+    size_t NumOutput{0};
+
+    for(size_t Index{0}; Index < NumText; ++Index)
+    {
+        if unlikely(Text[Index] == ' ')
+        {
+            //a space at the start takes the place of a separator as well
+            if(bPendingSeparator || !bWroteWordSeparator)
+            {
+                Output[NumOutput++] = static_cast<char>(MorseCodes::NewWord);
+                bPendingSeparator = false;
+                bWroteWordSeparator = true;
+            }
+
+            continue;
+        }
+
+        uint16 PackedCode{Ranges::GetPackedMorseFromCharacter(Text[Index])};
+
+        if unlikely(Text[Index] == '<')
+        {
+            if(!bLast && NumText - Index < MorseCodes::MaxProsignTextBytes)
+            {
+                NumHeld = NumText - Index;
+                std::copy_n(Text.begin() + static_cast<std::ptrdiff_t>(Index), NumHeld, Held.begin());
+                break;
+            }
+
+            size_t NumProsignBytes{0};
+            const uint16 ProsignCode{GetPackedMorseFromProsignText(std::string_view{&Text[Index], NumText - Index}, NumProsignBytes)};
+
+            if(ProsignCode != 0)
+            {
+                PackedCode = ProsignCode;
+                Index += NumProsignBytes - 1;
+            }
+        }
+
+        if(bPendingSeparator)
+        {
+            Output[NumOutput++] = static_cast<char>(MorseCodes::SeparateChar);
+        }
+
+        const uint32 NumElements{static_cast<uint32>(std::bit_width(PackedCode) - 1)};
+
+        for(uint32 Element{0}; Element < NumElements; ++Element)
+        {
+            Output[NumOutput++] = static_cast<char>(((PackedCode >> (NumElements - 1 - Element)) & 1) ? MorseCodes::Long : MorseCodes::Short);
+        }
+
+        bPendingSeparator = true;
+        bWroteWordSeparator = false;
+    }
+
+    if(bLast && bPendingSeparator)
+    {
+        Output[NumOutput++] = static_cast<char>(MorseCodes::SeparateChar);
+        bPendingSeparator = false;
+    }
+
+    return NumOutput;
+}
@@ -0,0 +1,237 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "FileReader.h"
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <ranges>
+
+namespace Morse
+{
+    //input is pulled from the underlying range one register at a time
+    inline constexpr size_t BlockBytes{32};
+
+    //plain text to native morse-code byte for byte like -Encode: <Name> is one prosign, a character without a code is an empty code and its &,
+    //and a run of spaces turns the separator in front of it into one |. the separator of a character is held back until the next one shows
+    //whether it is a word space, and a '<' close to the end of a block until the next block shows whether a prosign name is closed
+    struct FEncodeCoder
+    {
+        static constexpr size_t MaxHeldBytes{MorseCodes::MaxProsignTextBytes - 1};
+        static constexpr size_t MaxOutputBytes{(MaxHeldBytes + BlockBytes) * (1 + MorseCodes::MaxPackedElements) + 1};
+
+        //what a file of this size usually encodes to, text averages fewer than three elements and a separator per character
+        static constexpr size_t GetExpectedOutputBytes(const size_t NumInputBytes) {return NumInputBytes * 4;}
+
+        std::array<char, MaxHeldBytes> Held{};
+        size_t NumHeld{0};
+
+        bool bPendingSeparator{false};
+        bool bWroteWordSeparator{false};
+
+        //bLast flushes the separator of the last character
+        size_t Process(char* Input, size_t NumInput, bool bLast, char* Output);
+    };
+
+    //the text of a packed code in the built-in alphabet
+    struct FBuiltInText
+    {
+        std::string_view operator()(const uint16 PackedCode) const {return GetTextFromPackedMorse(PackedCode);}
+    };
+
+    //native morse-code to plain text like -Decode, blanks and line breaks are stripped from each block with the SIMD kernel before it is decoded.
+    //LookupType turns a packed code into its text, which is the only thing that differs between the built-in alphabet and a loaded one
+    template<typename LookupType>
+    struct TDecodeCoder
+    {
+        //a separator and an element for the longest text and a space
+        static constexpr size_t MaxOutputBytes{BlockBytes * 6};
+
+        //a character every other byte, most files never grow past it
+        static constexpr size_t GetExpectedOutputBytes(const size_t NumInputBytes) {return NumInputBytes / 2;}
+
+        //first, so FDecodeCoder{true} decodes like -DecodeRepair. repairs to the nearest symbol of the built-in alphabet
+        bool bRepairUnrecognized{false};
+
+        [[no_unique_address]] LookupType Lookup{};
+
+        uint32 PackedCode{1};
+
+        //a code without a separator after it is dropped at the end
+        size_t Process(char* Input, const size_t NumInput, bool, char* Output)
+        {
+            size_t NumOutput{0};
+
+            const size_t NumKept{StripIgnorableBytes(Input, NumInput)};
+
+            for(size_t Index{0}; Index < NumKept; ++Index)
+            {
+                const char Symbol{Input[Index]};
+
+                if unlikely(Symbol == static_cast<char>(MorseCodes::SeparateChar) || Symbol == static_cast<char>(MorseCodes::NewWord))
+                {
+                    const std::string_view Text{Lookup(static_cast<uint16>(PackedCode))};
+
+                    if(bRepairUnrecognized && Text.front() == MorseCodes::Unrecognized)
+                    {
+                        Output[NumOutput++] = RepairCharacterFromPackedMorse(static_cast<uint16>(PackedCode));
+                    }
+                    else
+                    {
+                        NumOutput = static_cast<size_t>(std::copy(Text.begin(), Text.end(), Output + NumOutput) - Output);
+                    }
+
+                    if(Symbol == static_cast<char>(MorseCodes::NewWord))
+                    {
+                        Output[NumOutput++] = ' ';
+                    }
+
+                    PackedCode = 1;
+                }
+                else
+                {
+                    PackedCode = AddElementToPackedMorse(PackedCode, Symbol);
+                }
+            }
+
+            return NumOutput;
+        }
+    };
+
+    using FDecodeCoder = TDecodeCoder<FBuiltInText>;
+
+    //a lazy, single pass view over any range of characters. the coder fills an output block from each input block and the iterator walks it,
+    //so nothing in front of or behind the view is materialized
+    template<std::ranges::input_range ViewType, typename CoderType>
+        requires std::ranges::view<ViewType> && std::convertible_to<std::ranges::range_reference_t<ViewType>, char>
+    class TMorseCodingView final : public std::ranges::view_interface<TMorseCodingView<ViewType, CoderType>>
+    {
+    public:
+
+        TMorseCodingView() = default;
+
+        explicit TMorseCodingView(ViewType InBase)
+            : Base(std::move(InBase))
+        {
+        }
+
+        class FIterator
+        {
+        public:
+
+            using value_type = char;
+            using difference_type = std::ptrdiff_t;
+
+            FIterator() = default;
+
+            explicit FIterator(TMorseCodingView* InView)
+                : View(InView)
+            {
+            }
+
+            char operator*() const {return View->Output[View->OutputIndex];}
+
+            FIterator& operator++()
+            {
+                if(++View->OutputIndex == View->NumOutput)
+                {
+                    View->Refill();
+                }
+
+                return *this;
+            }
+
+            void operator++(int) {++*this;}
+
+            friend bool operator==(const FIterator& Iterator, std::default_sentinel_t) {return Iterator.IsAtEnd();}
+
+        private:
+
+            bool IsAtEnd() const {return View->OutputIndex == View->NumOutput;}
+
+            TMorseCodingView* View{nullptr};
+        };
+
+        //single pass, begin can only be called once
+        FIterator begin()
+        {
+            BaseIterator = std::ranges::begin(Base);
+            Refill();
+
+            return FIterator{this};
+        }
+
+        std::default_sentinel_t end() const {return std::default_sentinel;}
+
+    private:
+
+        void Refill()
+        {
+            OutputIndex = 0;
+            NumOutput = 0;
+
+            //a block can decode to nothing, for example the inside of a long code
+            while(NumOutput == 0 && !bFinished)
+            {
+                size_t NumInput{0};
+
+                for(; NumInput < BlockBytes && *BaseIterator != std::ranges::end(Base); ++*BaseIterator)
+                {
+                    Input[NumInput++] = static_cast<char>(**BaseIterator);
+                }
+
+                bFinished = NumInput < BlockBytes;
+                NumOutput = Coder.Process(Input.data(), NumInput, bFinished, Output.data());
+            }
+        }
+
+        ViewType Base{};
+        std::optional<std::ranges::iterator_t<ViewType>> BaseIterator{};
+
+        CoderType Coder{};
+
+        std::array<char, BlockBytes> Input{};
+        std::array<char, CoderType::MaxOutputBytes> Output{};
+
+        size_t OutputIndex{0};
+        size_t NumOutput{0};
+        bool bFinished{false};
+    };
+
+    template<typename ViewType>
+    using TEncodeView = TMorseCodingView<ViewType, FEncodeCoder>;
+
+    template<typename ViewType>
+    using TDecodeView = TMorseCodingView<ViewType, FDecodeCoder>;
+
+    //Range | Morse::Encode or Morse::Encode(Range), works on anything std::views::all accepts
+    template<typename CoderType>
+    struct TMorseAdaptor
+    {
+        template<std::ranges::viewable_range RangeType>
+        auto operator()(RangeType&& Range) const
+        {
+            return TMorseCodingView<std::views::all_t<RangeType>, CoderType>{std::views::all(std::forward<RangeType>(Range))};
+        }
+
+        template<std::ranges::viewable_range RangeType>
+        friend auto operator|(RangeType&& Range, const TMorseAdaptor& Adaptor)
+        {
+            return Adaptor(std::forward<RangeType>(Range));
+        }
+    };
+
+    inline constexpr TMorseAdaptor<FEncodeCoder> Encode{};
+    inline constexpr TMorseAdaptor<FDecodeCoder> Decode{};
+}
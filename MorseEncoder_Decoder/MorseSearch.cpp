@@ -0,0 +1,230 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "MorseSearch.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace MorseSearch
+{
+    constexpr size_t ReadChunkBytes{1 << 22};
+
+    //zeros after the data, so the shifted loads of the last register never leave the buffer
+    constexpr size_t Padding{64};
+
+    uint32 MatchByte(const char* Position, const __m256i Byte)
+    {
+        return static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(Position)), Byte)));
+    }
+
+    uint32 MatchSeparator(const char* Position)
+    {
+        const __m256i Bytes{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(Position))};
+
+        const __m256i SeparateChar{_mm256_cmpeq_epi8(Bytes, _mm256_set1_epi8(static_cast<char>(MorseCodes::SeparateChar)))};
+        const __m256i NewWord{_mm256_cmpeq_epi8(Bytes, _mm256_set1_epi8(static_cast<char>(MorseCodes::NewWord)))};
+
+        return static_cast<uint32>(_mm256_movemask_epi8(_mm256_or_si256(SeparateChar, NewWord)));
+    }
+
+    bool IsIgnorable(const char Character)
+    {
+        return Character == ' ' || Character == '\t' || Character == '\r' || Character == '\n';
+    }
+
+    //the search runs on the file without blanks, a second pass turns the offsets of matches back into offsets in the file
+    void MapToFileOffsets(std::fstream& FStream, std::vector<FMorseMatch>& Matches)
+    {
+        FStream.clear();
+        FStream.seekg(0, std::ios::beg);
+
+        std::vector<char> Chunk(ReadChunkBytes);
+
+        uint64 NumKeptBefore{0};
+        uint64 ChunkStart{0};
+        size_t Match{0};
+
+        while(Match < Matches.size() && (FStream.read(Chunk.data(), static_cast<std::streamsize>(Chunk.size())) || FStream.gcount() > 0))
+        {
+            const size_t NumRead{static_cast<size_t>(FStream.gcount())};
+            const uint64 NumKept{NumRead - static_cast<uint64>(std::count_if(Chunk.begin(), Chunk.begin() + static_cast<std::ptrdiff_t>(NumRead), IsIgnorable))};
+
+            //matches are in file order, only chunks holding one are walked byte by byte
+            for(size_t Position{0}, NumKeptInChunk{0}; Match < Matches.size() && Matches[Match].ByteOffset < NumKeptBefore + NumKept; ++Position)
+            {
+                if(IsIgnorable(Chunk[Position]))
+                {
+                    continue;
+                }
+
+                for(; Match < Matches.size() && Matches[Match].ByteOffset == NumKeptBefore + NumKeptInChunk; ++Match)
+                {
+                    Matches[Match].ByteOffset = ChunkStart + Position;
+                }
+
+                ++NumKeptInChunk;
+            }
+
+            NumKeptBefore += NumKept;
+            ChunkStart += NumRead;
+        }
+    }
+}
+
+std::string EncodeQueryToMorse(const std::string_view PlainTextQuery)
+{
+    std::string Morse{};
+
+    for(const char Character : PlainTextQuery)
+    {
+        if(Character == ' ')
+        {
+            if(!Morse.empty())
+            {
+                Morse.back() = static_cast<char>(MorseCodes::NewWord);
+            }
+            continue;
+        }
+
+        const Simd::int16_8 MorseCode{GetMorseFromCharacter(Character)};
+
+        if(PackMorseCode(MorseCode) <= 1)
+        {
+            std::cerr << "No morse-code for character: " << Character << std::endl;
+            return std::string{};
+        }
+
+        for(size_t Index{0}; Index < Simd::int16_8::GetNumElements() && MorseCode[Index] != 0; ++Index)
+        {
+            Morse.push_back(static_cast<char>(MorseCode[Index]));
+        }
+
+        Morse.push_back(static_cast<char>(MorseCodes::SeparateChar));
+    }
+
+    if(!Morse.empty())
+    {
+        Morse.pop_back();
+    }
+
+    return Morse;
+}
+
+std::vector<FMorseMatch> SearchMorse(const std::string& PathToFile, const std::string_view PlainTextQuery)
+{
+    std::vector<FMorseMatch> Matches{};
+
+    const std::string Needle{EncodeQueryToMorse(PlainTextQuery)};
+
+    if(Needle.empty())
+    {
+        return Matches;
+    }
+
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, std::ios::in | std::ios::binary);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return Matches;
+    }
+
+    //a match is the separator before it, the needle and the separator after it, so the last NeedleLength + 1 bytes wait for the next chunk
+    const size_t NeedleLength{Needle.size()};
+    const size_t NumCarried{NeedleLength + 1};
+
+    const __m256i FirstByte{_mm256_set1_epi8(Needle.front())};
+    const __m256i LastByte{_mm256_set1_epi8(Needle.back())};
+
+    std::vector<char> Buffer(1 + NumCarried + MorseSearch::ReadChunkBytes + MorseSearch::Padding);
+
+    //the byte before the file counts as a separator, so a match can start at offset 0
+    Buffer[0] = static_cast<char>(MorseCodes::SeparateChar);
+
+    size_t NumFilled{1};
+    int64 BufferStart{-1};
+    uint64 NumSeparators{0};
+    bool bStrippedBytes{false};
+
+    while(FStream.read(Buffer.data() + NumFilled, MorseSearch::ReadChunkBytes) || FStream.gcount() > 0)
+    {
+        const size_t NumRead{static_cast<size_t>(FStream.gcount())};
+        const size_t NumKept{StripIgnorableBytes(Buffer.data() + NumFilled, NumRead)};
+
+        bStrippedBytes |= NumKept != NumRead;
+        NumFilled += NumKept;
+        std::memset(Buffer.data() + NumFilled, 0, MorseSearch::Padding);
+
+        const size_t ScanEnd{NumFilled > NumCarried ? NumFilled - NumCarried : 0};
+
+        for(size_t Position{0}; Position < ScanEnd; Position += 32)
+        {
+            const uint32 InRange{ScanEnd - Position >= 32 ? ~0u : (1u << (ScanEnd - Position)) - 1};
+            const uint32 Separators{MorseSearch::MatchSeparator(&Buffer[Position]) & InRange};
+
+            //the first and last needle bytes plus both separators leave about one candidate in a few hundred positions
+            uint32 Candidates{Separators & MorseSearch::MatchByte(&Buffer[Position + 1], FirstByte) & MorseSearch::MatchByte(&Buffer[Position + NeedleLength], LastByte) & MorseSearch::MatchSeparator(&Buffer[Position + NeedleLength + 1])};
+
+            for(; Candidates != 0; Candidates &= Candidates - 1)
+            {
+                const uint32 Bit{static_cast<uint32>(std::countr_zero(Candidates))};
+
+                if(std::memcmp(&Buffer[Position + Bit + 1], Needle.data(), NeedleLength) == 0)
+                {
+                    //the separator in front is counted as well, the one standing in for the start of the file is not a character
+                    const uint64 SeparatorsUpToMatch{NumSeparators + static_cast<uint64>(std::popcount(Separators & static_cast<uint32>((static_cast<uint64>(2) << Bit) - 1)))};
+
+                    Matches.emplace_back(FMorseMatch{static_cast<uint64>(BufferStart + static_cast<int64>(Position + Bit + 1)), SeparatorsUpToMatch - 1});
+                }
+            }
+
+            NumSeparators += static_cast<uint64>(std::popcount(Separators));
+        }
+
+        std::memmove(Buffer.data(), Buffer.data() + ScanEnd, NumFilled - ScanEnd);
+
+        BufferStart += static_cast<int64>(ScanEnd);
+        NumFilled -= ScanEnd;
+    }
+
+    if(bStrippedBytes)
+    {
+        MorseSearch::MapToFileOffsets(FStream, Matches);
+    }
+
+    FStream.close();
+
+    return Matches;
+}
+
+void WriteToFile(const std::string& PathToOutFile, const std::vector<FMorseMatch>& MatchesToWrite)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToOutFile, std::ios::out);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToOutFile << std::endl;
+        return;
+    }
+
+    for(const FMorseMatch& Match : MatchesToWrite)
+    {
+        FStream << Match.ByteOffset << " " << Match.CharacterOffset << "\n";
+    }
+
+    FStream.close();
+}
@@ -0,0 +1,36 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "FileReader.h"
+#include <string_view>
+
+struct FMorseMatch
+{
+    //of the first symbol in the morse file
+    uint64 ByteOffset;
+
+    //the number of & and | in front of the match, the character count -DecodeCharacters and the word index take.
+    //a word space is not a character of its own here, while the -Decode text has a space after every |
+    uint64 CharacterOffset;
+};
+
+//encodes plain text the way EncodePlainTextToMorse does, without the separator after the last character, empty if a character has no code
+std::string EncodeQueryToMorse(std::string_view PlainTextQuery);
+
+//finds a plain-text query in a morse file without decoding it, matches have to start and end on a character boundary.
+//blanks and line breaks are skipped like the decoder does, so a match can be wrapped over lines
+std::vector<FMorseMatch> SearchMorse(const std::string& PathToFile, std::string_view PlainTextQuery);
+
+//one "<Byte Offset> <Character Offset>" line per match
+void WriteToFile(const std::string& PathToOutFile, const std::vector<FMorseMatch>& MatchesToWrite);
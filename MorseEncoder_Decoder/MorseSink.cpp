@@ -0,0 +1,38 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "MorseSink.h"
+#include <cerrno>
+#include <unistd.h>
+
+void FDescriptorSink::Write(const char* Bytes, size_t NumBytes)
+{
+    //a pipe or socket can take less than asked for
+    while(NumBytes > 0 && !bFailed)
+    {
+        const ssize_t NumWritten{::write(Descriptor, Bytes, NumBytes)};
+
+        if(NumWritten < 0)
+        {
+            if(errno != EINTR)
+            {
+                std::cerr << "Failed to write to file descriptor: " << Descriptor << std::endl;
+                bFailed = true;
+            }
+
+            continue;
+        }
+
+        Bytes += NumWritten;
+        NumBytes -= static_cast<size_t>(NumWritten);
+    }
+}
@@ -0,0 +1,272 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "MorseRanges.h"
+#include <concepts>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory_resource>
+#include <vector>
+
+//the kernels below gather this much output before every write, so a sink sees a few large writes instead of one per character
+inline constexpr size_t SinkBlockBytes{1 << 14};
+
+//anything output can be appended to in bulk: containers, streams, FILE*, file descriptors, a memory-mapped region or a user type with the same Write.
+//the kernels are templated on the sink, so Write is inlined into their loops
+template<typename SinkType>
+concept CByteSink = requires(SinkType& Sink, const char* Bytes, size_t NumBytes)
+{
+    Sink.Write(Bytes, NumBytes);
+};
+
+//std::string, std::vector<char> and their pmr versions
+template<typename ContainerType>
+struct TContainerSink
+{
+    ContainerType& Container;
+
+    void Reserve(const size_t NumBytes) {Container.reserve(Container.size() + NumBytes);}
+
+    void Write(const char* Bytes, const size_t NumBytes) {Container.insert(Container.end(), Bytes, Bytes + NumBytes);}
+};
+
+struct FStreamSink
+{
+    std::ostream& Stream;
+
+    void Write(const char* Bytes, const size_t NumBytes) {Stream.write(Bytes, static_cast<std::streamsize>(NumBytes));}
+};
+
+struct FFileSink
+{
+    std::FILE* File;
+
+    void Write(const char* Bytes, const size_t NumBytes) {std::fwrite(Bytes, 1, NumBytes, File);}
+};
+
+//unbuffered, every block is one write call. stops writing after the first error
+struct FDescriptorSink
+{
+    int Descriptor;
+    bool bFailed{false};
+
+    void Write(const char* Bytes, size_t NumBytes);
+};
+
+//a fixed region, for example a memory-mapped file. what does not fit is counted in NumBytes but not written, so the region can be grown and the output written again
+struct FMemorySink
+{
+    char* Data;
+    size_t Capacity;
+    size_t NumBytes{0};
+
+    bool HasOverflowed() const {return NumBytes > Capacity;}
+
+    void Write(const char* Bytes, const size_t NumNewBytes)
+    {
+        if(NumBytes < Capacity)
+        {
+            std::memcpy(Data + NumBytes, Bytes, std::min(NumNewBytes, Capacity - NumBytes));
+        }
+
+        NumBytes += NumNewBytes;
+    }
+};
+
+//the valid elements of one encoder register at Block, which needs room for the whole register, returns how many there are.
+//always stores and only advances over valid lanes, so there is no branch per lane
+template<typename RegisterType>
+size_t AppendValidElements(const RegisterType& Register, char* Block)
+{
+    size_t NumBytes{0};
+
+    for(size_t Index{0}; Index < RegisterType::GetNumElements(); ++Index)
+    {
+        Block[NumBytes] = static_cast<char>(Register[Index]);
+        NumBytes += Register[Index] != 0 && static_cast<char>(Register[Index]) != MorseCodes::Unrecognized;
+    }
+
+    return NumBytes;
+}
+
+//the valid elements of encoder registers, as the writers print them
+template<typename RegisterType, typename Allocator, CByteSink SinkType>
+void WriteValidElements(const std::vector<RegisterType, Allocator>& VectorRegisters, SinkType& Sink)
+{
+    std::array<char, SinkBlockBytes + RegisterType::GetNumElements()> Block;
+    size_t NumBytes{0};
+
+    for(const RegisterType& Register : VectorRegisters)
+    {
+        NumBytes += AppendValidElements(Register, &Block[NumBytes]);
+
+        if unlikely(NumBytes >= SinkBlockBytes)
+        {
+            Sink.Write(Block.data(), NumBytes);
+            NumBytes = 0;
+        }
+    }
+
+    if(NumBytes > 0)
+    {
+        Sink.Write(Block.data(), NumBytes);
+    }
+}
+
+//decoded text without Unrecognized characters, the runs between them are written as they are
+template<CByteSink SinkType>
+void WritePlainText(const char* Text, const size_t NumBytes, SinkType& Sink)
+{
+    for(const char* Run{Text}; Run < Text + NumBytes;)
+    {
+        const size_t NumLeft{static_cast<size_t>(Text + NumBytes - Run)};
+        const char* RunEnd{static_cast<const char*>(std::memchr(Run, MorseCodes::Unrecognized, NumLeft))};
+        const char* End{RunEnd != nullptr ? RunEnd : Run + NumLeft};
+
+        if(End != Run)
+        {
+            Sink.Write(Run, static_cast<size_t>(End - Run));
+        }
+
+        Run = End + (RunEnd != nullptr);
+    }
+}
+
+//passes decoded text on as WritePlainText writes it
+template<CByteSink SinkType>
+struct TPlainTextSink
+{
+    SinkType& Sink;
+
+    void Write(const char* Bytes, const size_t NumBytes) {WritePlainText(Bytes, NumBytes, Sink);}
+};
+
+//encoder output as registers for the vector API, eight elements to a register with the unused lanes of the last one left 0.
+//the writers only print the valid lanes, so the registers write the same text as the elements that went in
+template<typename VectorType>
+struct TRegisterSink
+{
+    using RegisterType = typename VectorType::value_type;
+
+    VectorType& Registers;
+    size_t NumLanes{RegisterType::GetNumElements()};
+
+    void Reserve(const size_t NumBytes) {Registers.reserve(Registers.size() + NumBytes / RegisterType::GetNumElements() + 1);}
+
+    void Write(const char* Bytes, const size_t NumBytes)
+    {
+        size_t Index{0};
+
+        for(; Index < NumBytes && NumLanes < RegisterType::GetNumElements(); ++Index)
+        {
+            Registers.back().Register[NumLanes++] = static_cast<int16>(Bytes[Index]);
+        }
+
+        if(Index == NumBytes)
+        {
+            return;
+        }
+
+        const size_t NumFirst{Registers.size()};
+        Registers.resize(NumFirst + (NumBytes - Index + RegisterType::GetNumElements() - 1) / RegisterType::GetNumElements());
+
+        for(size_t Register{NumFirst}; Index < NumBytes; ++Register)
+        {
+            for(NumLanes = 0; Index < NumBytes && NumLanes < RegisterType::GetNumElements(); ++Index)
+            {
+                Registers[Register].Register[NumLanes++] = static_cast<int16>(Bytes[Index]);
+            }
+        }
+    }
+};
+
+namespace Sinks
+{
+    //the one file driver of -Encode and -Decode: reads the file a block at a time through a block coder, nothing of the whole file is kept in memory.
+    //the file is only read front to back, so pipes and character devices work as well. the buffers come from Resource.
+    //a sink with a Reserve is reserved the expected output up front when the file can seek, so a vector in a monotonic arena is not left with its growth steps
+    template<typename CoderType, CByteSink SinkType>
+    bool CodeFile(const std::string& PathToFile, CoderType& Coder, SinkType& Sink, std::pmr::memory_resource* Resource = std::pmr::new_delete_resource())
+    {
+        std::fstream FStream{};
+
+        FStream.open(PathToFile, std::ios::in | std::ios::binary);
+
+        if(!FStream)
+        {
+            std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+            return false;
+        }
+
+        if constexpr(requires {Sink.Reserve(size_t{});})
+        {
+            if(const size_t NumFileBytes{GetRemainingBytes(FStream)}; NumFileBytes > 0)
+            {
+                Sink.Reserve(CoderType::GetExpectedOutputBytes(NumFileBytes));
+            }
+        }
+
+        constexpr size_t MaxBlockOutputBytes{SinkBlockBytes / Morse::BlockBytes * CoderType::MaxOutputBytes};
+
+        std::pmr::vector<char> Chunk(SinkBlockBytes, Resource);
+        std::pmr::vector<char> Output(MaxBlockOutputBytes + CoderType::MaxOutputBytes, Resource);
+
+        while(FStream.read(Chunk.data(), static_cast<std::streamsize>(Chunk.size())) || FStream.gcount() > 0)
+        {
+            const size_t NumRead{static_cast<size_t>(FStream.gcount())};
+
+            size_t NumOutput{0};
+
+            for(size_t Block{0}; Block < NumRead; Block += Morse::BlockBytes)
+            {
+                NumOutput += Coder.Process(&Chunk[Block], std::min(Morse::BlockBytes, NumRead - Block), false, &Output[NumOutput]);
+            }
+
+            if(NumOutput > 0)
+            {
+                Sink.Write(Output.data(), NumOutput);
+            }
+        }
+
+        if(const size_t NumOutput{Coder.Process(Chunk.data(), 0, true, Output.data())}; NumOutput > 0)
+        {
+            Sink.Write(Output.data(), NumOutput);
+        }
+
+        FStream.close();
+
+        return true;
+    }
+}
+
+//the file encoded like -Encode straight into the sink, a block at a time
+template<CByteSink SinkType>
+bool EncodePlainTextToSink(const std::string& PathToFile, SinkType& Sink)
+{
+    Morse::FEncodeCoder Coder{};
+
+    return Sinks::CodeFile(PathToFile, Coder, Sink);
+}
+
+//the file decoded like -Decode straight into the sink, Unrecognized characters are left out as the writers do
+template<CByteSink SinkType>
+bool DecodeMorseToSink(const std::string& PathToFile, SinkType& Sink, const bool bRepairUnrecognized = false)
+{
+    TPlainTextSink<SinkType> PlainTextSink{Sink};
+    Morse::FDecodeCoder Coder{bRepairUnrecognized};
+
+    return Sinks::CodeFile(PathToFile, Coder, PlainTextSink);
+}
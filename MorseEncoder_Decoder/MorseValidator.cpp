@@ -0,0 +1,323 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "MorseValidator.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace Validation
+{
+    //a multiple of the block size, so only the last block of a file is partial
+    constexpr size_t ReadChunkBytes{1 << 22};
+    constexpr size_t BlockBytes{64};
+
+    constexpr uint32 MaxCodeBytes{MorseCodes::MaxSymbolElements};
+
+    struct FBlockMasks
+    {
+        uint64 Separators;
+        uint64 Elements;
+
+        //blanks and line breaks, the decoder strips them so they neither end a code nor count towards its length
+        uint64 Ignorable;
+    };
+
+    //the code that runs on into the next block
+    struct FCodeRun
+    {
+        //elements and invalid bytes since the last separator
+        uint64 NumBytes{0};
+
+        //of the first of them
+        uint64 Start{0};
+    };
+
+    uint64 MatchBytes(const __m256i Low, const __m256i High, const int16 Symbol)
+    {
+        const __m256i Byte{_mm256_set1_epi8(static_cast<char>(Symbol))};
+
+        return static_cast<uint64>(static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(Low, Byte)))) | static_cast<uint64>(static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(High, Byte)))) << 32;
+    }
+
+    FBlockMasks ClassifyBlock(const char* Block)
+    {
+        const __m256i Low{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(Block))};
+        const __m256i High{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(Block + 32))};
+
+        return FBlockMasks
+        {
+            MatchBytes(Low, High, MorseCodes::SeparateChar) | MatchBytes(Low, High, MorseCodes::NewWord),
+            MatchBytes(Low, High, MorseCodes::Short) | MatchBytes(Low, High, MorseCodes::Long),
+            MatchBytes(Low, High, ' ') | MatchBytes(Low, High, '\t') | MatchBytes(Low, High, '\r') | MatchBytes(Low, High, '\n')
+        };
+    }
+
+    bool IsIgnorable(const char Character)
+    {
+        return Character == ' ' || Character == '\t' || Character == '\r' || Character == '\n';
+    }
+
+    //keeps the code in progress until its separator shows whether it is valid, a dropped code takes its separator along.
+    //blanks stay where they are in kept codes
+    struct FSkipWriter
+    {
+        std::vector<char>& MorseText;
+
+        std::string Code{};
+
+        //elements and invalid bytes, against the over-long limit
+        uint32 NumCodeBytes{0};
+        uint32 NumElements{0};
+
+        bool bDropping{false};
+
+        bool IsClean() const {return !bDropping && NumCodeBytes == NumElements;}
+
+        void Write(const char Character)
+        {
+            if(Character == static_cast<char>(MorseCodes::SeparateChar) || Character == static_cast<char>(MorseCodes::NewWord))
+            {
+                //a code of nothing but invalid bytes is dropped as well, an empty one (the encoder's line break) is kept
+                if(bDropping || (NumCodeBytes > 0 && NumElements == 0))
+                {
+                    if(Character == static_cast<char>(MorseCodes::NewWord) && !MorseText.empty() && MorseText.back() == static_cast<char>(MorseCodes::SeparateChar))
+                    {
+                        MorseText.back() = Character;
+                    }
+                }
+                else
+                {
+                    MorseText.insert(MorseText.end(), Code.begin(), Code.end());
+                    MorseText.emplace_back(Character);
+                }
+
+                Code.clear();
+                NumCodeBytes = 0;
+                NumElements = 0;
+                bDropping = false;
+            }
+            else if(IsIgnorable(Character))
+            {
+                if(!bDropping)
+                {
+                    Code.push_back(Character);
+                }
+            }
+            else if(++NumCodeBytes > MaxCodeBytes)
+            {
+                bDropping = true;
+                Code.clear();
+            }
+            else if(Character == static_cast<char>(MorseCodes::Short) || Character == static_cast<char>(MorseCodes::Long))
+            {
+                Code.push_back(Character);
+                ++NumElements;
+            }
+        }
+
+        //error-free bytes, everything up to the last separator is final
+        void WriteClean(const char* Bytes, const size_t NumBytes, const uint64 Separators, const uint64 Ignorable)
+        {
+            if(Separators == 0)
+            {
+                Code.append(Bytes, NumBytes);
+                NumCodeBytes += static_cast<uint32>(NumBytes - static_cast<size_t>(std::popcount(Ignorable)));
+            }
+            else
+            {
+                const size_t LastSeparator{static_cast<size_t>(63 - std::countl_zero(Separators))};
+
+                MorseText.insert(MorseText.end(), Code.begin(), Code.end());
+                MorseText.insert(MorseText.end(), Bytes, Bytes + LastSeparator + 1);
+
+                Code.assign(Bytes + LastSeparator + 1, NumBytes - LastSeparator - 1);
+                //a block ending in a separator leaves no code, and a shift by 64 is undefined
+                NumCodeBytes = LastSeparator == 63 ? 0 : static_cast<uint32>(Code.size() - static_cast<size_t>(std::popcount(Ignorable >> (LastSeparator + 1))));
+            }
+
+            NumElements = NumCodeBytes;
+        }
+    };
+}
+
+FValidationResult ValidateMorseText(const std::string& PathToFile, const EValidationPolicy Policy)
+{
+    FValidationResult Result{};
+
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, std::ios::in | std::ios::binary);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return Result;
+    }
+
+    if(Policy == EValidationPolicy::Skip)
+    {
+        Result.MorseText.reserve(GetRemainingBytes(FStream));
+    }
+
+    std::vector<char> Chunk(Validation::ReadChunkBytes + Validation::BlockBytes);
+    Validation::FSkipWriter SkipWriter{Result.MorseText};
+
+    //the start of the file counts as a separator
+    Validation::FCodeRun Run{};
+
+    for(uint64 ChunkStart{0}; FStream.read(Chunk.data(), static_cast<std::streamsize>(Validation::ReadChunkBytes)) || FStream.gcount() > 0; ChunkStart += static_cast<uint64>(FStream.gcount()))
+    {
+        const size_t NumRead{static_cast<size_t>(FStream.gcount())};
+        std::memset(Chunk.data() + NumRead, 0, Validation::BlockBytes);
+
+        for(size_t Block{0}; Block < NumRead; Block += Validation::BlockBytes)
+        {
+            const size_t NumBytes{std::min(Validation::BlockBytes, NumRead - Block)};
+            const uint64 InRange{NumBytes == 64 ? ~uint64{0} : (uint64{1} << NumBytes) - 1};
+            const uint64 BlockStart{ChunkStart + Block};
+
+            const Validation::FBlockMasks Masks{Validation::ClassifyBlock(&Chunk[Block])};
+
+            const uint64 Separators{Masks.Separators & InRange};
+            const uint64 Ignorable{Masks.Ignorable & InRange};
+            const uint64 Invalid{~(Masks.Separators | Masks.Elements | Masks.Ignorable) & InRange};
+
+            //the first byte of every code that gets one byte longer than the longest symbol in this block, the error is reported there
+            std::array<uint64, Validation::BlockBytes / (Validation::MaxCodeBytes + 1) + 1> OverlongStarts{};
+            size_t NumOverlong{0};
+
+            //blanks neither end a code nor count towards its length, so the check runs on the masks with them left-packed out.
+            //bit i of a kept mask stands for the i-th byte that is no blank, ToOffset maps it back into the file
+            const bool bBlanks{Ignorable != 0};
+            const uint64 Kept{~Ignorable & InRange};
+            const uint32 NumKept{static_cast<uint32>(std::popcount(Kept))};
+            const uint64 KeptSeparators{bBlanks ? _pext_u64(Separators, Kept) : Separators};
+
+            auto ToOffset = [BlockStart, bBlanks, Kept](const uint32 KeptIndex) -> uint64
+            {
+                return BlockStart + (bBlanks ? static_cast<uint64>(std::countr_zero(_pdep_u64(uint64{1} << KeptIndex, Kept))) : KeptIndex);
+            };
+
+            //a byte ends a run of MaxCodeBytes + 1 non-separators if it and the MaxCodeBytes bytes in front of it are all non-separators
+            const uint64 NonSeparators{~KeptSeparators};
+            const uint64 PreviousNonSeparators{Run.NumBytes >= 64 ? ~uint64{0} : ~(~uint64{0} >> Run.NumBytes)};
+
+            uint64 OverlongRuns{NonSeparators};
+
+            for(uint32 Shift{1}; Shift <= Validation::MaxCodeBytes; ++Shift)
+            {
+                OverlongRuns &= (NonSeparators << Shift) | (PreviousNonSeparators >> (64 - Shift));
+            }
+
+            const uint64 KeptOverlongEnds{OverlongRuns & ~((OverlongRuns << 1) | static_cast<uint64>(Run.NumBytes > Validation::MaxCodeBytes)) & (NumKept == 64 ? ~uint64{0} : (uint64{1} << NumKept) - 1)};
+
+            for(uint64 Bits{KeptOverlongEnds}; Bits != 0; Bits &= Bits - 1)
+            {
+                const uint64 SeparatorsInFront{KeptSeparators & ((uint64{1} << std::countr_zero(Bits)) - 1)};
+
+                OverlongStarts[NumOverlong++] = SeparatorsInFront != 0 ? ToOffset(static_cast<uint32>(64 - std::countl_zero(SeparatorsInFront))) : Run.NumBytes > 0 ? Run.Start : ToOffset(0);
+            }
+
+            //the bytes that make their code over-long
+            const uint64 OverlongEnds{bBlanks ? _pdep_u64(KeptOverlongEnds, Kept) : KeptOverlongEnds};
+
+            if(KeptSeparators != 0)
+            {
+                const uint32 LastSeparator{static_cast<uint32>(63 - std::countl_zero(KeptSeparators))};
+
+                Run.NumBytes = NumKept - 1 - LastSeparator;
+                Run.Start = Run.NumBytes > 0 ? ToOffset(LastSeparator + 1) : Run.Start;
+            }
+            else if(NumKept > 0)
+            {
+                Run.Start = Run.NumBytes > 0 ? Run.Start : ToOffset(0);
+                Run.NumBytes += NumKept;
+            }
+
+            if(Policy == EValidationPolicy::Skip)
+            {
+                if((Invalid | OverlongEnds) == 0 && SkipWriter.IsClean())
+                {
+                    SkipWriter.WriteClean(&Chunk[Block], NumBytes, Separators, Ignorable);
+                }
+                else
+                {
+                    for(size_t Index{0}; Index < NumBytes; ++Index)
+                    {
+                        SkipWriter.Write(Chunk[Block + Index]);
+                    }
+                }
+            }
+
+            if likely((Invalid | OverlongEnds) == 0)
+            {
+                continue;
+            }
+
+            size_t Overlong{0};
+
+            for(uint64 Bits{Invalid | OverlongEnds}; Bits != 0; Bits &= Bits - 1)
+            {
+                const uint32 Bit{static_cast<uint32>(std::countr_zero(Bits))};
+
+                if((OverlongEnds >> Bit) & 1)
+                {
+                    Result.Errors.emplace_back(FMorseError{OverlongStarts[Overlong++], EMorseError::OverlongCode});
+                }
+                if((Invalid >> Bit) & 1)
+                {
+                    Result.Errors.emplace_back(FMorseError{BlockStart + Bit, EMorseError::InvalidByte});
+                }
+
+                if(Policy == EValidationPolicy::Strict)
+                {
+                    Result.Errors.resize(1);
+                    return Result;
+                }
+            }
+        }
+    }
+
+    FStream.close();
+
+    //the last code has no separator after it, it stays as the decoder would see it
+    if(Policy == EValidationPolicy::Skip && !SkipWriter.bDropping)
+    {
+        Result.MorseText.insert(Result.MorseText.end(), SkipWriter.Code.begin(), SkipWriter.Code.end());
+    }
+
+    //an over-long code is found at its last byte, after invalid bytes inside it
+    std::stable_sort(Result.Errors.begin(), Result.Errors.end(), [](const FMorseError& A, const FMorseError& B) -> bool {return A.ByteOffset < B.ByteOffset;});
+
+    return Result;
+}
+
+void WriteToFile(const std::string& PathToOutFile, const std::vector<FMorseError>& ErrorsToWrite)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToOutFile, std::ios::out);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToOutFile << std::endl;
+        return;
+    }
+
+    for(const FMorseError& Error : ErrorsToWrite)
+    {
+        FStream << Error.ByteOffset << (Error.Kind == EMorseError::InvalidByte ? " invalid byte" : " over-long code") << "\n";
+    }
+
+    FStream.close();
+}
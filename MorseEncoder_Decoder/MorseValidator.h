@@ -0,0 +1,49 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "FileReader.h"
+
+enum class EValidationPolicy : uint8
+{
+    Strict, //stops at the first error
+    Skip,   //reports every error and keeps the input without them
+    Report  //reports every error
+};
+
+enum class EMorseError : uint8
+{
+    InvalidByte,    //anything but * - & |
+    OverlongCode    //more bytes between two separators than the longest symbol (SOS) has elements
+};
+
+struct FMorseError
+{
+    //of the invalid byte, or of the first byte of the over-long code
+    uint64 ByteOffset;
+    EMorseError Kind;
+};
+
+struct FValidationResult
+{
+    std::vector<FMorseError> Errors{};
+
+    //only filled with EValidationPolicy::Skip, invalid bytes and over-long codes are dropped so the decoder reads it without Unrecognized characters
+    std::vector<char> MorseText{};
+};
+
+//classifies 64 bytes per step with AVX2 compares, error-free blocks never leave the vector path
+FValidationResult ValidateMorseText(const std::string& PathToFile, EValidationPolicy Policy);
+
+//one "<Byte Offset> <invalid byte/over-long code>" line per error
+void WriteToFile(const std::string& PathToOutFile, const std::vector<FMorseError>& ErrorsToWrite);
@@ -0,0 +1,734 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "NoisyDecoder.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <iterator>
+
+namespace NoisyMorse
+{
+    constexpr float32 Impossible{std::numeric_limits<float32>::infinity()};
+
+    constexpr uint8 NoSymbol{0xFF};
+
+    //elements between two tracebacks, survivors usually agree on everything but the last few characters long before that
+    constexpr size_t CommitInterval{1 << 10};
+
+    constexpr size_t ReadChunkBytes{1 << 14};
+
+    enum class EBoundary : uint8
+    {
+        None,
+        Character,
+        Word
+    };
+
+    //the pattern and the context it was read in are kept so confidence only has to be computed along the winning path
+    struct FHypothesis
+    {
+        float32 Score;
+        size_t Parent;
+        uint16 Pattern;
+        char Character;
+        bool bWordBreak;
+        uint8 ContextPreviousPrevious;
+        uint8 ContextPrevious;
+        uint8 PreviousPrevious;
+        uint8 Previous;
+    };
+
+    //one entry per hypothesis and element since the last commit, Commit drops whatever the survivors no longer refer to
+    struct FHistoryEntry
+    {
+        size_t Parent;
+        uint16 Pattern;
+        char Character;
+        bool bWordBreak;
+        uint8 ContextPreviousPrevious;
+        uint8 ContextPrevious;
+    };
+
+    constexpr size_t NoParent{std::numeric_limits<size_t>::max()};
+
+    std::array<uint8, 256> MakeSymbolIndices()
+    {
+        std::array<uint8, 256> SymbolIndices{};
+        SymbolIndices.fill(NoSymbol);
+
+        for(size_t Index{0}; Index < MorseCodes::Alphabet.size(); ++Index)
+        {
+            const uint8 Character{static_cast<uint8>(MorseCodes::Alphabet[Index])};
+
+            SymbolIndices[Character] = static_cast<uint8>(Index);
+
+            if(Character >= 'A' && Character <= 'Z')
+            {
+                SymbolIndices[Character + 32] = static_cast<uint8>(Index);
+            }
+        }
+
+        for(const uint8 Whitespace : {' ', '\t', '\n', '\r'})
+        {
+            SymbolIndices[Whitespace] = SpaceSymbol;
+        }
+
+        return SymbolIndices;
+    }
+
+    uint8 GetPatternLength(const uint16 PackedCode)
+    {
+        return static_cast<uint8>(std::bit_width(PackedCode) - 1);
+    }
+
+    void StoreRow(Simd::float32_8* Row, const float32* Values)
+    {
+        for(size_t Register{0}; Register < NumRegistersPerRow; ++Register)
+        {
+            Row[Register] = Simd::float32_8{_mm256_loadu_ps(Values + Register * Simd::float32_8::GetNumElements())};
+        }
+    }
+}
+
+FCharacterLanguageModel::FCharacterLanguageModel()
+    : Costs(NoisyMorse::NumContexts * NoisyMorse::NumContexts * NoisyMorse::NumRegistersPerRow)
+{
+    using namespace NoisyMorse;
+
+    std::array<float32, NumSymbols> UniformRow{};
+    UniformRow.fill(Impossible);
+
+    for(size_t Symbol{0}; Symbol <= SpaceSymbol; ++Symbol)
+    {
+        UniformRow[Symbol] = std::log(static_cast<float32>(SpaceSymbol + 1));
+    }
+
+    for(size_t Context{0}; Context < NumContexts * NumContexts; ++Context)
+    {
+        StoreRow(&Costs[Context * NumRegistersPerRow], UniformRow.data());
+    }
+}
+
+bool FCharacterLanguageModel::Train(const std::string& PathToCorpus)
+{
+    using namespace NoisyMorse;
+
+    std::fstream FStream{};
+
+    FStream.open(PathToCorpus, std::ios::in);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToCorpus << std::endl;
+        return false;
+    }
+
+    static const std::array<uint8, 256> SymbolIndices{MakeSymbolIndices()};
+
+    std::vector<uint32> UnigramCounts(NumContexts, 0);
+    std::vector<uint32> BigramCounts(NumContexts * NumContexts, 0);
+    std::vector<uint32> TrigramCounts(NumContexts * NumContexts * NumContexts, 0);
+    uint64 TotalCount{0};
+
+    uint8 PreviousPrevious{StartSymbol};
+    uint8 Previous{StartSymbol};
+
+    for(std::istreambuf_iterator<char> Iterator{FStream}, End{}; Iterator != End; ++Iterator)
+    {
+        const uint8 Symbol{SymbolIndices[static_cast<uint8>(*Iterator)]};
+
+        if(Symbol == NoSymbol || (Symbol == SpaceSymbol && Previous == SpaceSymbol))
+        {
+            continue;
+        }
+
+        ++UnigramCounts[Symbol];
+        ++BigramCounts[Previous * NumContexts + Symbol];
+        ++TrigramCounts[(PreviousPrevious * NumContexts + Previous) * NumContexts + Symbol];
+        ++TotalCount;
+
+        PreviousPrevious = Previous;
+        Previous = Symbol;
+    }
+
+    FStream.close();
+
+    if(TotalCount == 0)
+    {
+        return false;
+    }
+
+    constexpr float32 TrigramWeight{0.6f};
+    constexpr float32 BigramWeight{0.3f};
+    constexpr float32 UnigramWeight{0.1f};
+
+    std::vector<uint32> BigramContextCounts(NumContexts, 0);
+    std::vector<uint32> TrigramContextCounts(NumContexts * NumContexts, 0);
+
+    for(size_t Context{0}; Context < NumContexts; ++Context)
+    {
+        for(size_t Symbol{0}; Symbol < NumContexts; ++Symbol)
+        {
+            BigramContextCounts[Context] += BigramCounts[Context * NumContexts + Symbol];
+        }
+    }
+
+    for(size_t Context{0}; Context < NumContexts * NumContexts; ++Context)
+    {
+        for(size_t Symbol{0}; Symbol < NumContexts; ++Symbol)
+        {
+            TrigramContextCounts[Context] += TrigramCounts[Context * NumContexts + Symbol];
+        }
+    }
+
+    std::array<float32, NumSymbols> Row{};
+
+    for(size_t PreviousPreviousContext{0}; PreviousPreviousContext < NumContexts; ++PreviousPreviousContext)
+    {
+        for(size_t PreviousContext{0}; PreviousContext < NumContexts; ++PreviousContext)
+        {
+            const size_t TrigramContext{PreviousPreviousContext * NumContexts + PreviousContext};
+
+            Row.fill(Impossible);
+
+            for(size_t Symbol{0}; Symbol <= SpaceSymbol; ++Symbol)
+            {
+                float32 Probability{UnigramWeight * static_cast<float32>(UnigramCounts[Symbol] + 1) / static_cast<float32>(TotalCount + SpaceSymbol + 1)};
+                float32 UsedWeight{UnigramWeight};
+
+                if(BigramContextCounts[PreviousContext] != 0)
+                {
+                    Probability += BigramWeight * static_cast<float32>(BigramCounts[PreviousContext * NumContexts + Symbol]) / static_cast<float32>(BigramContextCounts[PreviousContext]);
+                    UsedWeight += BigramWeight;
+                }
+
+                if(TrigramContextCounts[TrigramContext] != 0)
+                {
+                    Probability += TrigramWeight * static_cast<float32>(TrigramCounts[TrigramContext * NumContexts + Symbol]) / static_cast<float32>(TrigramContextCounts[TrigramContext]);
+                    UsedWeight += TrigramWeight;
+                }
+
+                Row[Symbol] = -std::log(Probability / UsedWeight);
+            }
+
+            StoreRow(&Costs[TrigramContext * NumRegistersPerRow], Row.data());
+        }
+    }
+
+    return true;
+}
+
+FNoisyMorseDecoder::FNoisyMorseDecoder(const FCharacterLanguageModel& InLanguageModel, const FNoisyDecoderSettings& InSettings)
+    : LanguageModel(InLanguageModel)
+    , Settings(InSettings)
+    , MaxSymbolLength(0)
+{
+    using namespace NoisyMorse;
+
+    check(Settings.BeamWidth > 0)
+
+    std::array<uint16, MorseCodes::Alphabet.size()> PackedCodes{};
+
+    for(size_t Symbol{0}; Symbol < MorseCodes::Alphabet.size(); ++Symbol)
+    {
+        PackedCodes[Symbol] = PackMorseCode(GetMorseFromCharacter(MorseCodes::Alphabet[Symbol]));
+        MaxSymbolLength = std::max(MaxSymbolLength, GetPatternLength(PackedCodes[Symbol]));
+    }
+
+    const size_t NumPatterns{static_cast<size_t>(2) << MaxSymbolLength};
+
+    ChannelCosts.resize(NumPatterns * NumRegistersPerRow);
+
+    std::array<float32, NumSymbols> Row{};
+
+    for(uint16 Pattern{1}; Pattern < NumPatterns; ++Pattern)
+    {
+        Row.fill(Impossible);
+
+        for(size_t Symbol{0}; Symbol < MorseCodes::Alphabet.size(); ++Symbol)
+        {
+            if(GetPatternLength(PackedCodes[Symbol]) == GetPatternLength(Pattern))
+            {
+                Row[Symbol] = Settings.FlipCost * static_cast<float32>(std::popcount(static_cast<uint16>(PackedCodes[Symbol] ^ Pattern)));
+            }
+        }
+
+        StoreRow(&ChannelCosts[Pattern * NumRegistersPerRow], Row.data());
+    }
+}
+
+//beam search over an element stream, the prefix every surviving hypothesis shares is written to the result as it is found
+struct FNoisyMorseDecoder::FSearch
+{
+public:
+
+    explicit FSearch(const FNoisyMorseDecoder& InDecoder);
+
+    void Push(const char* Text, size_t NumText);
+
+    FNoisyDecodeResult Finish();
+
+private:
+
+    void Step(bool bLast);
+
+    void Insert(size_t Slot, const NoisyMorse::FHypothesis& Candidate);
+
+    //traces every survivor back, writes out the entries they all share and drops the history nobody refers to any more
+    void Commit();
+
+    void Emit(const NoisyMorse::FHistoryEntry& Entry);
+
+    float32 GetConfidence(const NoisyMorse::FHistoryEntry& Entry);
+
+    const FNoisyMorseDecoder& Decoder;
+
+    const size_t BeamWidth;
+    const size_t NumBeams;
+
+    std::vector<NoisyMorse::FHypothesis> BeamStorage;
+    std::vector<size_t> BeamCounts;
+    std::vector<float32> BeamWorstScores;
+
+    std::vector<NoisyMorse::FHistoryEntry> History{};
+
+    //elements from the one being expanded on, FirstElement is the position of the front one
+    std::vector<uint8> Elements{};
+    std::vector<NoisyMorse::EBoundary> Boundaries{};
+    size_t FirstElement{0};
+    size_t NumElements{0};
+
+    size_t Position{0};
+    size_t NextCommit{NoisyMorse::CommitInterval};
+
+    const Simd::float32_8 LanguageModelWeight;
+
+    alignas(Simd::float32_8) std::array<float32, NoisyMorse::NumSymbols> Costs{};
+
+    FNoisyDecodeResult Result{};
+};
+
+FNoisyMorseDecoder::FSearch::FSearch(const FNoisyMorseDecoder& InDecoder)
+    : Decoder(InDecoder)
+    , BeamWidth(InDecoder.Settings.BeamWidth)
+    , NumBeams(static_cast<size_t>(InDecoder.MaxSymbolLength) + 1)
+    , BeamStorage(NumBeams * BeamWidth)
+    , BeamCounts(NumBeams, 0)
+    , BeamWorstScores(NumBeams, NoisyMorse::Impossible)
+    , LanguageModelWeight(InDecoder.Settings.LanguageModelWeight)
+{
+    using namespace NoisyMorse;
+
+    History.reserve(CommitInterval * BeamWidth / 2 + 1);
+
+    Insert(0, FHypothesis{0.f, NoParent, 0, 0, false, StartSymbol, StartSymbol, StartSymbol, StartSymbol});
+}
+
+void FNoisyMorseDecoder::FSearch::Push(const char* Text, const size_t NumText)
+{
+    using namespace NoisyMorse;
+
+    for(size_t Index{0}; Index < NumText; ++Index)
+    {
+        const char Character{Text[Index]};
+
+        if(Character == static_cast<char>(MorseCodes::Short) || Character == static_cast<char>(MorseCodes::Long))
+        {
+            Elements.emplace_back(Character == static_cast<char>(MorseCodes::Long));
+            Boundaries.emplace_back(EBoundary::None);
+            ++NumElements;
+        }
+        else if(NumElements != 0 && Character == static_cast<char>(MorseCodes::SeparateChar))
+        {
+            Boundaries.back() = std::max(Boundaries.back(), EBoundary::Character);
+        }
+        else if(NumElements != 0 && Character == static_cast<char>(MorseCodes::NewWord))
+        {
+            Boundaries.back() = EBoundary::Word;
+        }
+    }
+
+    //the boundary after an element is only known once the next element has been read
+    while(Position + Decoder.MaxSymbolLength < NumElements)
+    {
+        Step(false);
+
+        if(Position >= NextCommit)
+        {
+            Commit();
+        }
+    }
+}
+
+FNoisyDecodeResult FNoisyMorseDecoder::FSearch::Finish()
+{
+    using namespace NoisyMorse;
+
+    if(NumElements == 0)
+    {
+        return FNoisyDecodeResult{};
+    }
+
+    while(Position < NumElements)
+    {
+        Step(true);
+    }
+
+    const size_t Slot{Position % NumBeams};
+    const FHypothesis* BestFinal{nullptr};
+
+    for(size_t BeamIndex{0}; BeamIndex < BeamCounts[Slot]; ++BeamIndex)
+    {
+        const FHypothesis& Hypothesis{BeamStorage[Slot * BeamWidth + BeamIndex]};
+
+        if(BestFinal == nullptr || Hypothesis.Score < BestFinal->Score)
+        {
+            BestFinal = &Hypothesis;
+        }
+    }
+
+    if(BestFinal == nullptr)
+    {
+        return std::move(Result);
+    }
+
+    std::vector<FHistoryEntry> Path{FHistoryEntry{BestFinal->Parent, BestFinal->Pattern, BestFinal->Character, BestFinal->bWordBreak, BestFinal->ContextPreviousPrevious, BestFinal->ContextPrevious}};
+
+    for(size_t Index{BestFinal->Parent}; Index != NoParent; Index = History[Index].Parent)
+    {
+        Path.emplace_back(History[Index]);
+    }
+
+    for(auto Entry{Path.rbegin()}; Entry != Path.rend(); ++Entry)
+    {
+        Emit(*Entry);
+    }
+
+    return std::move(Result);
+}
+
+void FNoisyMorseDecoder::FSearch::Step(const bool bLast)
+{
+    using namespace NoisyMorse;
+
+    const FNoisyDecoderSettings& Settings{Decoder.Settings};
+    const size_t Slot{Position % NumBeams};
+
+    for(size_t BeamIndex{0}; BeamIndex < BeamCounts[Slot]; ++BeamIndex)
+    {
+        const FHypothesis& Hypothesis{BeamStorage[Slot * BeamWidth + BeamIndex]};
+
+        const size_t HistoryIndex{History.size()};
+        History.emplace_back(FHistoryEntry{Hypothesis.Parent, Hypothesis.Pattern, Hypothesis.Character, Hypothesis.bWordBreak, Hypothesis.ContextPreviousPrevious, Hypothesis.ContextPrevious});
+
+        const Simd::float32_8* LanguageModelRow{Decoder.LanguageModel.GetCosts(Hypothesis.PreviousPrevious, Hypothesis.Previous)};
+
+        uint16 Pattern{1};
+        float32 SeparatorCost{0.f};
+
+        for(size_t Length{1}; Length <= Decoder.MaxSymbolLength && Position + Length <= NumElements; ++Length)
+        {
+            const size_t End{Position + Length};
+
+            if(Length > 1 && Boundaries[End - 2 - FirstElement] != EBoundary::None)
+            {
+                SeparatorCost += Boundaries[End - 2 - FirstElement] == EBoundary::Word ? Settings.ExtraWordSeparatorCost : Settings.ExtraSeparatorCost;
+            }
+
+            Pattern = static_cast<uint16>((Pattern << 1) | Elements[End - 1 - FirstElement]);
+
+            const EBoundary Boundary{bLast && End == NumElements ? EBoundary::Character : Boundaries[End - 1 - FirstElement]};
+
+            const Simd::float32_8 BaseCost{Hypothesis.Score + SeparatorCost + (Boundary == EBoundary::None ? Settings.MissingSeparatorCost : 0.f)};
+            const Simd::float32_8* ChannelRow{&Decoder.ChannelCosts[Pattern * NumRegistersPerRow]};
+
+            //only symbols that would still make it into the target beam are expanded, impossible readings never pass
+            const __m256 Threshold{_mm256_set1_ps(BeamWorstScores[End % NumBeams])};
+            uint64 ViableSymbols{0};
+
+            for(size_t Register{0}; Register < NumRegistersPerRow; ++Register)
+            {
+                const Simd::float32_8 Cost{Simd::FusedMultiplyAdd(LanguageModelRow[Register].Register, LanguageModelWeight.Register, ChannelRow[Register].Register)};
+                const __m256 TotalCost{(Cost + BaseCost).Register};
+
+                _mm256_store_ps(&Costs[Register * Simd::float32_8::GetNumElements()], TotalCost);
+                ViableSymbols |= static_cast<uint64>(_mm256_movemask_ps(_mm256_cmp_ps(TotalCost, Threshold, _CMP_LT_OQ))) << (Register * Simd::float32_8::GetNumElements());
+            }
+
+            for(; ViableSymbols != 0; ViableSymbols &= ViableSymbols - 1)
+            {
+                const uint8 Symbol{static_cast<uint8>(std::countr_zero(ViableSymbols))};
+
+                FHypothesis Candidate{Costs[Symbol], HistoryIndex, Pattern, MorseCodes::Alphabet[Symbol], false, Hypothesis.PreviousPrevious, Hypothesis.Previous, Hypothesis.Previous, Symbol};
+
+                if(Boundary == EBoundary::Word)
+                {
+                    const Simd::float32_8* SpaceRow{Decoder.LanguageModel.GetCosts(Hypothesis.Previous, Symbol)};
+
+                    Candidate.Score += Settings.LanguageModelWeight * SpaceRow[SpaceSymbol / Simd::float32_8::GetNumElements()][SpaceSymbol % Simd::float32_8::GetNumElements()];
+                    Candidate.bWordBreak = true;
+                    Candidate.PreviousPrevious = Symbol;
+                    Candidate.Previous = SpaceSymbol;
+                }
+
+                Insert(End % NumBeams, Candidate);
+            }
+        }
+    }
+
+    BeamCounts[Slot] = 0;
+    BeamWorstScores[Slot] = Impossible;
+
+    ++Position;
+}
+
+void FNoisyMorseDecoder::FSearch::Insert(const size_t Slot, const NoisyMorse::FHypothesis& Candidate)
+{
+    using namespace NoisyMorse;
+
+    FHypothesis* Beam{&BeamStorage[Slot * BeamWidth]};
+    size_t& Count{BeamCounts[Slot]};
+
+    if(Count == BeamWidth && Candidate.Score >= BeamWorstScores[Slot])
+    {
+        return;
+    }
+
+    size_t Worst{0};
+
+    for(size_t Index{0}; Index < Count; ++Index)
+    {
+        if(Beam[Index].Previous == Candidate.Previous && Beam[Index].PreviousPrevious == Candidate.PreviousPrevious)
+        {
+            if(Candidate.Score < Beam[Index].Score)
+            {
+                Beam[Index] = Candidate;
+            }
+            return;
+        }
+
+        if(Beam[Index].Score > Beam[Worst].Score)
+        {
+            Worst = Index;
+        }
+    }
+
+    if(Count < BeamWidth)
+    {
+        Beam[Count++] = Candidate;
+    }
+    else
+    {
+        Beam[Worst] = Candidate;
+    }
+
+    if(Count == BeamWidth)
+    {
+        float32 WorstScore{Beam[0].Score};
+
+        for(size_t Index{1}; Index < Count; ++Index)
+        {
+            WorstScore = std::max(WorstScore, Beam[Index].Score);
+        }
+
+        BeamWorstScores[Slot] = WorstScore;
+    }
+}
+
+void FNoisyMorseDecoder::FSearch::Commit()
+{
+    using namespace NoisyMorse;
+
+    NextCommit = Position + CommitInterval;
+
+    //parents always come before their children, so one backwards pass counts the children of every entry still in use
+    std::vector<uint32> NumChildren(History.size(), 0);
+    std::vector<size_t> Children(History.size(), NoParent);
+
+    for(size_t Slot{0}; Slot < NumBeams; ++Slot)
+    {
+        for(size_t BeamIndex{0}; BeamIndex < BeamCounts[Slot]; ++BeamIndex)
+        {
+            const size_t Parent{BeamStorage[Slot * BeamWidth + BeamIndex].Parent};
+
+            if(Parent != NoParent)
+            {
+                ++NumChildren[Parent];
+            }
+        }
+    }
+
+    for(size_t Index{History.size()}; Index-- > 0;)
+    {
+        if(NumChildren[Index] != 0 && History[Index].Parent != NoParent)
+        {
+            ++NumChildren[History[Index].Parent];
+            Children[History[Index].Parent] = Index;
+        }
+    }
+
+    const auto Root{std::find_if(NumChildren.begin(), NumChildren.end(), [](const uint32 Count) { return Count != 0; })};
+
+    if(Root == NumChildren.end())
+    {
+        return;
+    }
+
+    //the root is shared by every survivor, and so is each entry below it for as long as the tree does not branch
+    size_t Shared{static_cast<size_t>(Root - NumChildren.begin())};
+
+    for(;;)
+    {
+        Emit(History[Shared]);
+
+        if(NumChildren[Shared] != 1 || Children[Shared] == NoParent)
+        {
+            break;
+        }
+
+        Shared = Children[Shared];
+    }
+
+    //the last written entry stays on as the root, with nothing left to write, so the next commit still finds one shared ancestor
+    History[0] = FHistoryEntry{NoParent, 0, 0, false, StartSymbol, StartSymbol};
+
+    //everything else still in use hangs below it, renumbered in place since parents move before their children
+    std::vector<size_t>& NewIndices{Children};
+    NewIndices[Shared] = 0;
+    size_t NumKept{1};
+
+    for(size_t Index{Shared + 1}; Index < History.size(); ++Index)
+    {
+        if(NumChildren[Index] != 0)
+        {
+            const size_t Parent{History[Index].Parent};
+
+            History[NumKept] = History[Index];
+            History[NumKept].Parent = NewIndices[Parent];
+            NewIndices[Index] = NumKept++;
+        }
+    }
+
+    History.resize(NumKept);
+
+    for(size_t Slot{0}; Slot < NumBeams; ++Slot)
+    {
+        for(size_t BeamIndex{0}; BeamIndex < BeamCounts[Slot]; ++BeamIndex)
+        {
+            size_t& Parent{BeamStorage[Slot * BeamWidth + BeamIndex].Parent};
+
+            if(Parent != NoParent)
+            {
+                Parent = NewIndices[Parent];
+            }
+        }
+    }
+
+    Elements.erase(Elements.begin(), Elements.begin() + static_cast<std::ptrdiff_t>(Position - FirstElement));
+    Boundaries.erase(Boundaries.begin(), Boundaries.begin() + static_cast<std::ptrdiff_t>(Position - FirstElement));
+    FirstElement = Position;
+}
+
+void FNoisyMorseDecoder::FSearch::Emit(const NoisyMorse::FHistoryEntry& Entry)
+{
+    if(Entry.Character == 0)
+    {
+        return;
+    }
+
+    Result.PlainText.emplace_back(Entry.Character);
+    Result.Confidence.emplace_back(GetConfidence(Entry));
+
+    if(Entry.bWordBreak)
+    {
+        Result.PlainText.emplace_back(' ');
+        Result.Confidence.emplace_back(1.f);
+    }
+}
+
+//softmax over every symbol the winning pattern could have been read as in the same context
+float32 FNoisyMorseDecoder::FSearch::GetConfidence(const NoisyMorse::FHistoryEntry& Entry)
+{
+    using namespace NoisyMorse;
+
+    const Simd::float32_8* LanguageModelRow{Decoder.LanguageModel.GetCosts(Entry.ContextPreviousPrevious, Entry.ContextPrevious)};
+    const Simd::float32_8* ChannelRow{&Decoder.ChannelCosts[Entry.Pattern * NumRegistersPerRow]};
+
+    for(size_t Register{0}; Register < NumRegistersPerRow; ++Register)
+    {
+        const Simd::float32_8 Cost{Simd::FusedMultiplyAdd(LanguageModelRow[Register].Register, LanguageModelWeight.Register, ChannelRow[Register].Register)};
+        _mm256_store_ps(&Costs[Register * Simd::float32_8::GetNumElements()], Cost.Register);
+    }
+
+    const size_t Symbol{static_cast<size_t>(std::find(MorseCodes::Alphabet.begin(), MorseCodes::Alphabet.end(), Entry.Character) - MorseCodes::Alphabet.begin())};
+
+    float32 Normalizer{0.f};
+
+    for(size_t Other{0}; Other < SpaceSymbol; ++Other)
+    {
+        if(Costs[Other] != Impossible)
+        {
+            Normalizer += std::exp(Costs[Symbol] - Costs[Other]);
+        }
+    }
+
+    return 1.f / Normalizer;
+}
+
+FNoisyDecodeResult FNoisyMorseDecoder::Decode(const std::string& PathToFile) const
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, std::ios::in);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return FNoisyDecodeResult{};
+    }
+
+    FSearch Search{*this};
+    std::array<char, NoisyMorse::ReadChunkBytes> Chunk{};
+
+    while(FStream.read(Chunk.data(), static_cast<std::streamsize>(Chunk.size())) || FStream.gcount() > 0)
+    {
+        Search.Push(Chunk.data(), static_cast<size_t>(FStream.gcount()));
+    }
+
+    FStream.close();
+
+    return Search.Finish();
+}
+
+FNoisyDecodeResult FNoisyMorseDecoder::Decode(const std::vector<char>& MorseText) const
+{
+    FSearch Search{*this};
+
+    Search.Push(MorseText.data(), MorseText.size());
+
+    return Search.Finish();
+}
+
+std::vector<char> FormatConfidence(const std::vector<float32>& Confidence)
+{
+    std::vector<char> Digits{};
+    Digits.reserve(Confidence.size());
+
+    for(const float32 Value : Confidence)
+    {
+        Digits.emplace_back(static_cast<char>('0' + std::clamp(static_cast<int32>(Value * 10.f), 0, 9)));
+    }
+
+    return Digits;
+}
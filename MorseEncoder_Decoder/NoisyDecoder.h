@@ -0,0 +1,94 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "FileReader.h"
+
+namespace NoisyMorse
+{
+    //alphabet characters, then the word space, padded so a row of costs fills whole float32_8 registers
+    inline constexpr size_t NumSymbols{56};
+    inline constexpr size_t NumRegistersPerRow{NumSymbols / Simd::float32_8::GetNumElements()};
+
+    inline constexpr uint8 SpaceSymbol{static_cast<uint8>(MorseCodes::Alphabet.size())};
+    inline constexpr uint8 StartSymbol{SpaceSymbol + 1};
+    inline constexpr size_t NumContexts{StartSymbol + 1};
+
+    static_assert(NumSymbols % Simd::float32_8::GetNumElements() == 0);
+    static_assert(NumContexts <= NumSymbols);
+}
+
+//interpolated character trigram model, stored as -log probabilities
+class FCharacterLanguageModel final
+{
+public:
+
+    FCharacterLanguageModel();
+
+    bool Train(const std::string& PathToCorpus);
+
+    const Simd::float32_8* GetCosts(uint8 PreviousPrevious, uint8 Previous) const
+    {
+        return &Costs[(PreviousPrevious * NoisyMorse::NumContexts + Previous) * NoisyMorse::NumRegistersPerRow];
+    }
+
+private:
+
+    std::vector<Simd::float32_8> Costs;
+};
+
+struct FNoisyDecoderSettings
+{
+    size_t BeamWidth{16};
+    float32 FlipCost{3.f};
+
+    //reading through or inventing a separator has to cost more than a character costs in the language model (about 4 with the uniform one),
+    //otherwise the beam merges neighbouring characters of clean input into one
+    float32 MissingSeparatorCost{12.f};
+    float32 ExtraSeparatorCost{12.f};
+
+    //a dropped word space loses more than a character boundary
+    float32 ExtraWordSeparatorCost{18.f};
+    float32 LanguageModelWeight{1.f};
+};
+
+struct FNoisyDecodeResult
+{
+    std::vector<char> PlainText;
+    std::vector<float32> Confidence;
+};
+
+class FNoisyMorseDecoder final
+{
+public:
+
+    explicit FNoisyMorseDecoder(const FCharacterLanguageModel& InLanguageModel, const FNoisyDecoderSettings& InSettings = {});
+
+    FNoisyDecodeResult Decode(const std::string& PathToFile) const;
+
+    FNoisyDecodeResult Decode(const std::vector<char>& MorseText) const;
+
+private:
+
+    struct FSearch;
+
+    const FCharacterLanguageModel& LanguageModel;
+    FNoisyDecoderSettings Settings;
+
+    //cost of reading each symbol out of a packed element pattern, one row per pattern
+    std::vector<Simd::float32_8> ChannelCosts;
+    uint8 MaxSymbolLength;
+};
+
+//one digit per character, 0 = under 10% confident, 9 = at least 90% confident
+std::vector<char> FormatConfidence(const std::vector<float32>& Confidence);
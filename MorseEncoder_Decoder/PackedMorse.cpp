@@ -0,0 +1,332 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "PackedMorse.h"
+#include <algorithm>
+#include <bit>
+
+namespace PackedMorse
+{
+    constexpr uint64 LowBits{0x5555555555555555};
+
+    //the high bit of a symbol is only set for & and |, so its popcount is the number of characters
+    constexpr uint64 HighBits{0xAAAAAAAAAAAAAAAA};
+
+    constexpr size_t SymbolsPerWord{32};
+    constexpr size_t ReadChunkBytes{1 << 20};
+
+    //appends bit fields of up to 64 bits to a word stream
+    struct FBitWriter
+    {
+        std::vector<uint64>& Words;
+        uint64 Pending{0};
+        uint32 NumPendingBits{0};
+
+        void Append(const uint64 Bits, const uint32 NumBits)
+        {
+            Pending |= Bits << NumPendingBits;
+
+            if(NumPendingBits + NumBits >= 64)
+            {
+                Words.emplace_back(Pending);
+                Pending = NumPendingBits == 0 ? 0 : Bits >> (64 - NumPendingBits);
+                NumPendingBits = NumPendingBits + NumBits - 64;
+            }
+            else
+            {
+                NumPendingBits += NumBits;
+            }
+        }
+
+        void Finish()
+        {
+            if(NumPendingBits > 0)
+            {
+                Words.emplace_back(Pending);
+            }
+        }
+    };
+
+    //packs 32 bytes of text into 2 bit symbols, bytes that are not a symbol are squeezed out
+    uint64 PackSymbols(const char* Text, uint32& OutNumSymbols)
+    {
+        const __m256i Bytes{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(Text))};
+
+        auto Match = [&Bytes](const int16 Symbol) -> uint32
+        {
+            return static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(Bytes, _mm256_set1_epi8(static_cast<char>(Symbol)))));
+        };
+
+        const uint32 Short{Match(MorseCodes::Short)};
+        const uint32 Long{Match(MorseCodes::Long)};
+        const uint32 SeparateChar{Match(MorseCodes::SeparateChar)};
+        const uint32 NewWord{Match(MorseCodes::NewWord)};
+
+        const uint32 Valid{Short | Long | SeparateChar | NewWord};
+        const uint64 Symbols{_pdep_u64(Long | NewWord, LowBits) | _pdep_u64(SeparateChar | NewWord, HighBits)};
+
+        OutNumSymbols = static_cast<uint32>(std::popcount(Valid));
+
+        return _pext_u64(Symbols, _pdep_u64(Valid, LowBits) * 3);
+    }
+
+    //one byte per bit, all ones where the bit is set
+    __m256i ExpandBitsToBytes(const uint32 Bits)
+    {
+        const __m256i Selector{_mm256_set1_epi64x(static_cast<int64>(0x8040201008040201))};
+        const __m256i Spread{_mm256_shuffle_epi8(_mm256_set1_epi32(static_cast<int32>(Bits)), _mm256_setr_epi64x(0x0000000000000000, 0x0101010101010101, 0x0202020202020202, 0x0303030303030303))};
+
+        return _mm256_cmpeq_epi8(_mm256_and_si256(Spread, Selector), Selector);
+    }
+
+    bool ReadHeaderAndIndex(std::fstream& FStream, const std::string& PathToFile, FPackedMorse& OutPacked)
+    {
+        if(!FStream.read(reinterpret_cast<char*>(&OutPacked.Header), sizeof(FPackedMorseHeader)) || OutPacked.Header.Magic != FPackedMorseHeader{}.Magic)
+        {
+            std::cerr << "Not a packed morse file: " << PathToFile << std::endl;
+            return false;
+        }
+
+        OutPacked.Index.resize(OutPacked.Header.NumBlocks);
+
+        return static_cast<bool>(FStream.read(reinterpret_cast<char*>(OutPacked.Index.data()), static_cast<std::streamsize>(OutPacked.Index.size() * sizeof(FPackedMorseBlock))));
+    }
+}
+
+FPackedMorse PackMorseText(const std::string& PathToFile)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, std::ios::in | std::ios::binary);
+
+    FPackedMorse Packed{};
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return Packed;
+    }
+
+    PackedMorse::FBitWriter Writer{Packed.Words};
+
+    //the tail of every chunk is padded with zeros, which are not symbols and get squeezed out
+    std::vector<char> Chunk(PackedMorse::ReadChunkBytes + PackedMorse::SymbolsPerWord);
+
+    while(FStream.read(Chunk.data(), PackedMorse::ReadChunkBytes) || FStream.gcount() > 0)
+    {
+        const size_t NumRead{static_cast<size_t>(FStream.gcount())};
+
+        std::fill_n(Chunk.begin() + static_cast<std::ptrdiff_t>(NumRead), PackedMorse::SymbolsPerWord, 0);
+
+        for(size_t Offset{0}; Offset < NumRead; Offset += PackedMorse::SymbolsPerWord)
+        {
+            uint32 NumSymbols;
+            const uint64 Symbols{PackedMorse::PackSymbols(&Chunk[Offset], NumSymbols)};
+
+            Writer.Append(Symbols, NumSymbols * 2);
+            Packed.Header.NumSymbols += NumSymbols;
+        }
+    }
+
+    Writer.Finish();
+
+    FStream.close();
+
+    FPackedMorseHeader& Header{Packed.Header};
+
+    const size_t WordsPerBlock{Header.SymbolsPerBlock / PackedMorse::SymbolsPerWord};
+
+    Header.NumBlocks = (Header.NumSymbols + Header.SymbolsPerBlock - 1) / Header.SymbolsPerBlock;
+
+    //the last block is padded with *, which never completes a character
+    Packed.Words.resize(Header.NumBlocks * WordsPerBlock, 0);
+
+    const uint64 DataOffset{sizeof(FPackedMorseHeader) + Header.NumBlocks * sizeof(FPackedMorseBlock)};
+
+    for(uint64 Block{0}; Block < Header.NumBlocks; ++Block)
+    {
+        Packed.Index.emplace_back(FPackedMorseBlock{DataOffset + Block * WordsPerBlock * sizeof(uint64), Header.NumCharacters});
+
+        for(size_t Word{Block * WordsPerBlock}; Word < (Block + 1) * WordsPerBlock; ++Word)
+        {
+            Header.NumCharacters += static_cast<uint64>(std::popcount(Packed.Words[Word] & PackedMorse::HighBits));
+        }
+    }
+
+    return Packed;
+}
+
+std::vector<char> UnpackMorseText(const std::string& PathToFile)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, std::ios::in | std::ios::binary);
+
+    std::vector<char> MorseTextVector{};
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return MorseTextVector;
+    }
+
+    FPackedMorse Packed{};
+
+    if(!PackedMorse::ReadHeaderAndIndex(FStream, PathToFile, Packed))
+    {
+        return MorseTextVector;
+    }
+
+    Packed.Words.resize(Packed.Header.NumBlocks * Packed.Header.SymbolsPerBlock / PackedMorse::SymbolsPerWord);
+    FStream.read(reinterpret_cast<char*>(Packed.Words.data()), static_cast<std::streamsize>(Packed.Words.size() * sizeof(uint64)));
+
+    FStream.close();
+
+    MorseTextVector.resize(Packed.Words.size() * PackedMorse::SymbolsPerWord);
+
+    const __m256i Short{_mm256_set1_epi8(static_cast<char>(MorseCodes::Short))};
+    const __m256i Long{_mm256_set1_epi8(static_cast<char>(MorseCodes::Long))};
+    const __m256i SeparateChar{_mm256_set1_epi8(static_cast<char>(MorseCodes::SeparateChar))};
+    const __m256i NewWord{_mm256_set1_epi8(static_cast<char>(MorseCodes::NewWord))};
+
+    for(size_t Word{0}; Word < Packed.Words.size(); ++Word)
+    {
+        const __m256i Low{PackedMorse::ExpandBitsToBytes(static_cast<uint32>(_pext_u64(Packed.Words[Word], PackedMorse::LowBits)))};
+        const __m256i High{PackedMorse::ExpandBitsToBytes(static_cast<uint32>(_pext_u64(Packed.Words[Word], PackedMorse::HighBits)))};
+
+        __m256i Text{_mm256_blendv_epi8(Short, Long, Low)};
+        Text = _mm256_blendv_epi8(Text, SeparateChar, High);
+        Text = _mm256_blendv_epi8(Text, NewWord, _mm256_and_si256(Low, High));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&MorseTextVector[Word * PackedMorse::SymbolsPerWord]), Text);
+    }
+
+    MorseTextVector.resize(Packed.Header.NumSymbols);
+
+    return MorseTextVector;
+}
+
+std::vector<char> DecodePackedMorseToPlainText(const std::string& PathToFile, const uint64 FirstCharacter, const uint64 NumCharacters)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, std::ios::in | std::ios::binary);
+
+    std::vector<char> PlainTextVector{};
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return PlainTextVector;
+    }
+
+    FPackedMorse Packed{};
+
+    if(!PackedMorse::ReadHeaderAndIndex(FStream, PathToFile, Packed) || FirstCharacter >= Packed.Header.NumCharacters || NumCharacters == 0)
+    {
+        return PlainTextVector;
+    }
+
+    size_t Block{0};
+    uint64 SeparatorsToSkip{0};
+
+    //a character starts right after the separator that ends the one before it, which lies in the last block starting before that character
+    if(FirstCharacter > 0)
+    {
+        Block = static_cast<size_t>(std::lower_bound(Packed.Index.begin(), Packed.Index.end(), FirstCharacter, [](const FPackedMorseBlock& Entry, const uint64 Character) -> bool
+        {
+            return Entry.FirstCharacter < Character;
+        }) - Packed.Index.begin()) - 1;
+
+        SeparatorsToSkip = FirstCharacter - Packed.Index[Block].FirstCharacter;
+    }
+
+    FStream.seekg(static_cast<std::streamoff>(Packed.Index[Block].ByteOffset));
+
+    std::vector<uint64> Words(Packed.Header.SymbolsPerBlock / PackedMorse::SymbolsPerWord);
+
+    uint16 PackedCode{1};
+    uint64 NumDecoded{0};
+
+    for(; Block < Packed.Header.NumBlocks; ++Block)
+    {
+        FStream.read(reinterpret_cast<char*>(Words.data()), static_cast<std::streamsize>(Words.size() * sizeof(uint64)));
+
+        for(const uint64 Word : Words)
+        {
+            uint32 FirstSymbol{0};
+
+            //whole words of separators are skipped by popcount, the last one is found with pdep and tzcnt
+            if(SeparatorsToSkip > 0)
+            {
+                const uint64 Separators{Word & PackedMorse::HighBits};
+                const uint64 NumSeparators{static_cast<uint64>(std::popcount(Separators))};
+
+                if(NumSeparators < SeparatorsToSkip)
+                {
+                    SeparatorsToSkip -= NumSeparators;
+                    continue;
+                }
+
+                FirstSymbol = static_cast<uint32>(std::countr_zero(_pdep_u64(static_cast<uint64>(1) << (SeparatorsToSkip - 1), Separators))) / 2 + 1;
+                SeparatorsToSkip = 0;
+            }
+
+            for(uint32 Symbol{FirstSymbol}; Symbol < PackedMorse::SymbolsPerWord; ++Symbol)
+            {
+                const uint32 Code{static_cast<uint32>(Word >> (Symbol * 2)) & 3};
+
+                if(Code < 2)
+                {
+                    PackedCode = static_cast<uint16>(std::min<uint32>((PackedCode << 1) | Code, 0xFFFF));
+                    continue;
+                }
+
+                const std::string_view Text{GetTextFromPackedMorse(PackedCode)};
+                PlainTextVector.insert(PlainTextVector.end(), Text.begin(), Text.end());
+
+                if(Code == 3)
+                {
+                    PlainTextVector.emplace_back(' ');
+                }
+
+                PackedCode = 1;
+
+                if(++NumDecoded == NumCharacters)
+                {
+                    return PlainTextVector;
+                }
+            }
+        }
+    }
+
+    return PlainTextVector;
+}
+
+void WriteToFile(const std::string& PathToOutFile, const FPackedMorse& PackedToWrite)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToOutFile, std::ios::out | std::ios::binary);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToOutFile << std::endl;
+        return;
+    }
+
+    FStream.write(reinterpret_cast<const char*>(&PackedToWrite.Header), sizeof(FPackedMorseHeader));
+    FStream.write(reinterpret_cast<const char*>(PackedToWrite.Index.data()), static_cast<std::streamsize>(PackedToWrite.Index.size() * sizeof(FPackedMorseBlock)));
+    FStream.write(reinterpret_cast<const char*>(PackedToWrite.Words.data()), static_cast<std::streamsize>(PackedToWrite.Words.size() * sizeof(uint64)));
+
+    FStream.close();
+}
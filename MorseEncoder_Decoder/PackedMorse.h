@@ -0,0 +1,56 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "FileReader.h"
+#include <limits>
+
+//file layout: header, one index entry per block, then the blocks.
+//symbols take 2 bits, * = 0, - = 1, & = 2, | = 3, 32 to a little-endian uint64 with the first symbol in the lowest bits
+struct FPackedMorseHeader
+{
+    std::array<char, 4> Magic{'M', 'P', '2', 'B'};
+    uint32 SymbolsPerBlock{1 << 16};
+    uint64 NumSymbols{0};
+    uint64 NumCharacters{0};
+    uint64 NumBlocks{0};
+};
+
+static_assert(sizeof(FPackedMorseHeader) == 32, "The header is written as it is laid out in memory");
+
+struct FPackedMorseBlock
+{
+    //from the start of the file
+    uint64 ByteOffset;
+
+    //number of characters completed before the block, which is also the character its first symbol belongs to
+    uint64 FirstCharacter;
+};
+
+struct FPackedMorse
+{
+    FPackedMorseHeader Header{};
+    std::vector<FPackedMorseBlock> Index{};
+    std::vector<uint64> Words{};
+};
+
+//only the four morse symbols are kept, anything else (line breaks, spaces) is dropped
+FPackedMorse PackMorseText(const std::string& PathToFile);
+
+//back to the * - & | text format
+std::vector<char> UnpackMorseText(const std::string& PathToFile);
+
+//decodes NumCharacters characters starting at the FirstCharacter-th, reading only the index and the blocks from there on
+std::vector<char> DecodePackedMorseToPlainText(const std::string& PathToFile, uint64 FirstCharacter = 0, uint64 NumCharacters = std::numeric_limits<uint64>::max());
+
+void WriteToFile(const std::string& PathToOutFile, const FPackedMorse& PackedToWrite);
@@ -0,0 +1,193 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "RangeDecoder.h"
+#include "MorseRanges.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+namespace RangeDecode
+{
+    //a page is small, so the decode pass reads little past its end
+    constexpr size_t ReadChunkBytes{1 << 16};
+    constexpr size_t CountChunkBytes{1 << 20};
+
+    bool IsSeparator(const char Character)
+    {
+        return Character == static_cast<char>(MorseCodes::SeparateChar) || Character == static_cast<char>(MorseCodes::NewWord);
+    }
+
+    uint32 MatchSeparators(const char* Position)
+    {
+        const __m256i Bytes{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(Position))};
+
+        const __m256i SeparateChar{_mm256_cmpeq_epi8(Bytes, _mm256_set1_epi8(static_cast<char>(MorseCodes::SeparateChar)))};
+        const __m256i NewWord{_mm256_cmpeq_epi8(Bytes, _mm256_set1_epi8(static_cast<char>(MorseCodes::NewWord)))};
+
+        return static_cast<uint32>(_mm256_movemask_epi8(_mm256_or_si256(SeparateChar, NewWord)));
+    }
+
+    //the stream has to stand at Position, which has to be the start of a character,
+    //decoding stops before a character starting at or after EndByte or once NumCharacters are out.
+    //the blocks go through the -Decode kernel cut after the separator that ends the range, so blanks and bytes of no symbol decode the same as there
+    std::vector<char> DecodeFrom(std::fstream& FStream, uint64 Position, const uint64 EndByte, uint64 NumCharacters)
+    {
+        std::vector<char> PlainTextVector{};
+
+        if(Position >= EndByte || NumCharacters == 0)
+        {
+            return PlainTextVector;
+        }
+
+        //the character whose separator lies here or after it is the last one
+        const uint64 LastSeparator{EndByte - 1};
+
+        Morse::FDecodeCoder Coder{};
+
+        std::vector<char> Chunk(ReadChunkBytes + Morse::BlockBytes);
+        std::array<char, Morse::FDecodeCoder::MaxOutputBytes> Output;
+
+        while(FStream.read(Chunk.data(), static_cast<std::streamsize>(ReadChunkBytes)) || FStream.gcount() > 0)
+        {
+            const size_t NumRead{static_cast<size_t>(FStream.gcount())};
+            std::memset(Chunk.data() + NumRead, 0, Morse::BlockBytes);
+
+            for(size_t Block{0}; Block < NumRead; Block += Morse::BlockBytes, Position += Morse::BlockBytes)
+            {
+                size_t NumInput{std::min(Morse::BlockBytes, NumRead - Block)};
+
+                const uint32 Separators{MatchSeparators(&Chunk[Block]) & (NumInput == Morse::BlockBytes ? ~0u : (1u << NumInput) - 1)};
+                const uint32 NumSeparators{static_cast<uint32>(std::popcount(Separators))};
+
+                uint32 LastSeparators{NumSeparators >= NumCharacters ? _pdep_u32(1u << (NumCharacters - 1), Separators) : 0};
+
+                if(LastSeparator < Position + NumInput)
+                {
+                    LastSeparators |= Separators & (~0u << (LastSeparator > Position ? LastSeparator - Position : 0));
+                }
+
+                if(LastSeparators != 0)
+                {
+                    NumInput = static_cast<size_t>(std::countr_zero(LastSeparators)) + 1;
+                }
+
+                const size_t NumOutput{Coder.Process(&Chunk[Block], NumInput, false, Output.data())};
+                PlainTextVector.insert(PlainTextVector.end(), Output.data(), Output.data() + NumOutput);
+
+                if(LastSeparators != 0)
+                {
+                    return PlainTextVector;
+                }
+
+                NumCharacters -= NumSeparators;
+            }
+        }
+
+        return PlainTextVector;
+    }
+}
+
+std::vector<char> DecodeMorseByteRangeToPlainText(const std::string& PathToFile, const uint64 FirstByte, const uint64 NumBytes)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, std::ios::in | std::ios::binary);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return std::vector<char>{};
+    }
+
+    const uint64 EndByte{NumBytes > std::numeric_limits<uint64>::max() - FirstByte ? std::numeric_limits<uint64>::max() : FirstByte + NumBytes};
+
+    uint64 Position{FirstByte};
+
+    if(FirstByte > 0)
+    {
+        //the character in front of the range ends at the first separator from FirstByte - 1 on
+        FStream.seekg(static_cast<std::streamoff>(FirstByte - 1));
+
+        for(char Character{}; FStream.get(Character) && !RangeDecode::IsSeparator(Character);)
+        {
+            ++Position;
+        }
+    }
+
+    std::vector<char> PlainTextVector{RangeDecode::DecodeFrom(FStream, Position, EndByte, std::numeric_limits<uint64>::max())};
+
+    FStream.close();
+
+    return PlainTextVector;
+}
+
+std::vector<char> DecodeMorseCharacterRangeToPlainText(const std::string& PathToFile, const uint64 FirstCharacter, const uint64 NumCharacters)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, std::ios::in | std::ios::binary);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return std::vector<char>{};
+    }
+
+    uint64 Position{0};
+
+    if(FirstCharacter > 0)
+    {
+        //the FirstCharacter-th separator ends the character in front, 32 bytes are counted at a time
+        std::vector<char> Chunk(RangeDecode::CountChunkBytes + 32);
+
+        uint64 NumRemaining{FirstCharacter};
+        uint64 ChunkStart{0};
+
+        while(Position == 0 && (FStream.read(Chunk.data(), static_cast<std::streamsize>(RangeDecode::CountChunkBytes)) || FStream.gcount() > 0))
+        {
+            const size_t NumRead{static_cast<size_t>(FStream.gcount())};
+            std::memset(Chunk.data() + NumRead, 0, 32);
+
+            for(size_t Offset{0}; Offset < NumRead; Offset += 32)
+            {
+                const uint32 Separators{RangeDecode::MatchSeparators(&Chunk[Offset])};
+                const uint32 NumSeparators{static_cast<uint32>(std::popcount(Separators))};
+
+                if(NumSeparators >= NumRemaining)
+                {
+                    Position = ChunkStart + Offset + static_cast<uint64>(std::countr_zero(_pdep_u32(1u << (NumRemaining - 1), Separators))) + 1;
+                    break;
+                }
+
+                NumRemaining -= NumSeparators;
+            }
+
+            ChunkStart += NumRead;
+        }
+
+        if(Position == 0)
+        {
+            return std::vector<char>{};
+        }
+
+        FStream.clear();
+        FStream.seekg(static_cast<std::streamoff>(Position));
+    }
+
+    std::vector<char> PlainTextVector{RangeDecode::DecodeFrom(FStream, Position, std::numeric_limits<uint64>::max(), NumCharacters)};
+
+    FStream.close();
+
+    return PlainTextVector;
+}
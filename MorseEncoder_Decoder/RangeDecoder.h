@@ -0,0 +1,24 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "FileReader.h"
+
+//decodes the characters whose first symbol lies in [FirstByte, FirstByte + NumBytes), a character cut by FirstByte is skipped by resyncing after the next & or |.
+//back to back ranges decode every character exactly once, so a file can be paged through with fixed-size byte windows.
+//characters decode as in DecodeMorseToPlainText, blanks and line breaks are skipped and a byte of no symbol makes its character Unrecognized
+std::vector<char> DecodeMorseByteRangeToPlainText(const std::string& PathToFile, uint64 FirstByte, uint64 NumBytes);
+
+//decodes NumCharacters characters starting at the FirstCharacter-th, counted the way -Decode ends them.
+//the separators in front are only counted, not decoded, for repeated jumps into one file -PackMorse keeps an index instead
+std::vector<char> DecodeMorseCharacterRangeToPlainText(const std::string& PathToFile, uint64 FirstCharacter, uint64 NumCharacters);
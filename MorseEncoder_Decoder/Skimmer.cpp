@@ -0,0 +1,364 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "Skimmer.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <mutex>
+#include <numbers>
+#include <thread>
+
+namespace Skimmer
+{
+    //frames overlap by three quarters so a 30 ms dot still spans several envelope values
+    constexpr size_t HopDivisor{4};
+
+    //only every HopDivisor-th frame is needed to find the carriers, which makes them non-overlapping
+    constexpr size_t DetectionFrameStride{HopDivisor};
+
+    //bins around DC hold the local oscillator leak of most receivers
+    constexpr size_t NumDcBins{1};
+
+    //runs Function(First, Last) over contiguous shares of [0, Count) on every hardware thread
+    template<typename Function>
+    void ParallelFor(const size_t Count, Function CallbackFunction)
+    {
+        const size_t NumWorkers{std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(), Count))};
+
+        std::vector<std::thread> Workers{};
+
+        for(size_t Worker{0}; Worker < NumWorkers; ++Worker)
+        {
+            Workers.emplace_back(CallbackFunction, Count * Worker / NumWorkers, Count * (Worker + 1) / NumWorkers);
+        }
+
+        for(std::thread& Worker : Workers)
+        {
+            Worker.join();
+        }
+    }
+
+    //per worker frame buffers, so the transform runs in place without allocating per frame
+    struct FFrame
+    {
+        explicit FFrame(const size_t Size) : Real(Size), Imaginary(Size), Power(Size) {}
+
+        std::vector<float32> Real;
+        std::vector<float32> Imaginary;
+        std::vector<float32> Power;
+    };
+
+    void ComputePowerSpectrum(const FPcmAudio& IqAudio, const size_t FirstSample, const std::vector<float32>& Window, const FFastFourierTransform& Transform, FFrame& Frame)
+    {
+        constexpr size_t NumLanes{Simd::float32_8::GetNumElements()};
+
+        const int16* Samples{&IqAudio.Samples[FirstSample * 2]};
+
+        for(size_t Sample{0}; Sample < Transform.GetSize(); Sample += NumLanes)
+        {
+            //eight I/Q pairs, each read as one int32 with I in the low and Q in the high half
+            const __m256i Pairs{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(Samples + Sample * 2))};
+            const Simd::float32_8 WindowRegister{_mm256_loadu_ps(&Window[Sample])};
+
+            const Simd::float32_8 InPhase{_mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(Pairs, 16), 16))};
+            const Simd::float32_8 Quadrature{_mm256_cvtepi32_ps(_mm256_srai_epi32(Pairs, 16))};
+
+            _mm256_storeu_ps(&Frame.Real[Sample], (InPhase * WindowRegister).Register);
+            _mm256_storeu_ps(&Frame.Imaginary[Sample], (Quadrature * WindowRegister).Register);
+        }
+
+        Transform.Forward(Frame.Real.data(), Frame.Imaginary.data());
+
+        for(size_t Bin{0}; Bin < Transform.GetSize(); Bin += NumLanes)
+        {
+            const Simd::float32_8 Real{_mm256_loadu_ps(&Frame.Real[Bin])};
+            const Simd::float32_8 Imaginary{_mm256_loadu_ps(&Frame.Imaginary[Bin])};
+
+            _mm256_storeu_ps(&Frame.Power[Bin], Simd::FusedMultiplyAdd(Real.Register, Real.Register, (Imaginary * Imaginary).Register));
+        }
+    }
+}
+
+FFastFourierTransform::FFastFourierTransform(const size_t InSize)
+    : Size(InSize)
+    , BitReversed(InSize)
+    , TwiddleReal(InSize)
+    , TwiddleImaginary(InSize)
+{
+    checkf(Size >= 16 && std::has_single_bit(Size), "FFT size has to be a power of two of at least 16")
+
+    const uint32 NumBits{static_cast<uint32>(std::countr_zero(Size))};
+
+    for(uint32 Index{0}; Index < Size; ++Index)
+    {
+        uint32 Reversed{0};
+
+        for(uint32 Bit{0}; Bit < NumBits; ++Bit)
+        {
+            Reversed |= ((Index >> Bit) & 1) << (NumBits - 1 - Bit);
+        }
+
+        BitReversed[Index] = Reversed;
+    }
+
+    for(size_t Half{1}; Half < Size; Half *= 2)
+    {
+        for(size_t Index{0}; Index < Half; ++Index)
+        {
+            const float64 Angle{-std::numbers::pi * static_cast<float64>(Index) / static_cast<float64>(Half)};
+
+            TwiddleReal[Half - 1 + Index] = static_cast<float32>(std::cos(Angle));
+            TwiddleImaginary[Half - 1 + Index] = static_cast<float32>(std::sin(Angle));
+        }
+    }
+}
+
+void FFastFourierTransform::Forward(float32* Real, float32* Imaginary) const
+{
+    constexpr size_t NumLanes{Simd::float32_8::GetNumElements()};
+
+    for(size_t Index{0}; Index < Size; ++Index)
+    {
+        if(Index < BitReversed[Index])
+        {
+            std::swap(Real[Index], Real[BitReversed[Index]]);
+            std::swap(Imaginary[Index], Imaginary[BitReversed[Index]]);
+        }
+    }
+
+    //the first three stages have fewer butterflies per group than lanes
+    for(size_t Half{1}; Half < NumLanes; Half *= 2)
+    {
+        for(size_t Start{0}; Start < Size; Start += Half * 2)
+        {
+            for(size_t Index{0}; Index < Half; ++Index)
+            {
+                const size_t Top{Start + Index};
+                const size_t Bottom{Top + Half};
+
+                const float32 WeightReal{TwiddleReal[Half - 1 + Index]};
+                const float32 WeightImaginary{TwiddleImaginary[Half - 1 + Index]};
+
+                const float32 ProductReal{Real[Bottom] * WeightReal - Imaginary[Bottom] * WeightImaginary};
+                const float32 ProductImaginary{Real[Bottom] * WeightImaginary + Imaginary[Bottom] * WeightReal};
+
+                Real[Bottom] = Real[Top] - ProductReal;
+                Imaginary[Bottom] = Imaginary[Top] - ProductImaginary;
+                Real[Top] += ProductReal;
+                Imaginary[Top] += ProductImaginary;
+            }
+        }
+    }
+
+    for(size_t Half{NumLanes}; Half < Size; Half *= 2)
+    {
+        for(size_t Start{0}; Start < Size; Start += Half * 2)
+        {
+            for(size_t Index{0}; Index < Half; Index += NumLanes)
+            {
+                float32* TopReal{Real + Start + Index};
+                float32* TopImaginary{Imaginary + Start + Index};
+                float32* BottomReal{TopReal + Half};
+                float32* BottomImaginary{TopImaginary + Half};
+
+                const Simd::float32_8 WeightReal{_mm256_loadu_ps(&TwiddleReal[Half - 1 + Index])};
+                const Simd::float32_8 WeightImaginary{_mm256_loadu_ps(&TwiddleImaginary[Half - 1 + Index])};
+
+                const Simd::float32_8 LowerReal{_mm256_loadu_ps(BottomReal)};
+                const Simd::float32_8 LowerImaginary{_mm256_loadu_ps(BottomImaginary)};
+
+                const Simd::float32_8 ProductReal{LowerReal * WeightReal - LowerImaginary * WeightImaginary};
+                const Simd::float32_8 ProductImaginary{Simd::FusedMultiplyAdd(LowerReal.Register, WeightImaginary.Register, (LowerImaginary * WeightReal).Register)};
+
+                const Simd::float32_8 UpperReal{_mm256_loadu_ps(TopReal)};
+                const Simd::float32_8 UpperImaginary{_mm256_loadu_ps(TopImaginary)};
+
+                _mm256_storeu_ps(BottomReal, (UpperReal - ProductReal).Register);
+                _mm256_storeu_ps(BottomImaginary, (UpperImaginary - ProductImaginary).Register);
+                _mm256_storeu_ps(TopReal, (UpperReal + ProductReal).Register);
+                _mm256_storeu_ps(TopImaginary, (UpperImaginary + ProductImaginary).Register);
+            }
+        }
+    }
+}
+
+std::vector<FSkimmerChannel> DecodeIq(const FPcmAudio& IqAudio, const FSkimmerSettings& Settings)
+{
+    checkf(IqAudio.NumChannels == 2, "IQ recordings need an I and a Q channel")
+
+    const FFastFourierTransform Transform{Settings.FftSize};
+
+    const size_t FftSize{Transform.GetSize()};
+    const size_t HopSamples{FftSize / Skimmer::HopDivisor};
+    const size_t NumSamples{IqAudio.Samples.size() / 2};
+    const size_t NumFrames{NumSamples >= FftSize ? (NumSamples - FftSize) / HopSamples + 1 : 0};
+
+    std::vector<FSkimmerChannel> Channels{};
+
+    if(NumFrames == 0)
+    {
+        return Channels;
+    }
+
+    std::vector<float32> Window(FftSize);
+
+    for(size_t Sample{0}; Sample < FftSize; ++Sample)
+    {
+        Window[Sample] = static_cast<float32>(0.5 - 0.5 * std::cos(2.0 * std::numbers::pi * static_cast<float64>(Sample) / static_cast<float64>(FftSize)));
+    }
+
+    //carriers are the bins whose mean power stands out of the median bin, which is the noise floor on any band that is not packed wall to wall
+    std::vector<float32> MeanPower(FftSize, 0.f);
+    std::mutex MeanPowerMutex{};
+
+    const size_t NumDetectionFrames{(NumFrames + Skimmer::DetectionFrameStride - 1) / Skimmer::DetectionFrameStride};
+
+    Skimmer::ParallelFor(NumDetectionFrames, [&](const size_t First, const size_t Last) -> void
+    {
+        Skimmer::FFrame Frame{FftSize};
+        std::vector<float32> SumPower(FftSize, 0.f);
+
+        for(size_t DetectionFrame{First}; DetectionFrame < Last; ++DetectionFrame)
+        {
+            Skimmer::ComputePowerSpectrum(IqAudio, DetectionFrame * Skimmer::DetectionFrameStride * HopSamples, Window, Transform, Frame);
+
+            for(size_t Bin{0}; Bin < FftSize; ++Bin)
+            {
+                SumPower[Bin] += Frame.Power[Bin];
+            }
+        }
+
+        const std::lock_guard<std::mutex> Lock{MeanPowerMutex};
+
+        for(size_t Bin{0}; Bin < FftSize; ++Bin)
+        {
+            MeanPower[Bin] += SumPower[Bin] / static_cast<float32>(NumDetectionFrames);
+        }
+    });
+
+    std::vector<float32> SortedPower{MeanPower};
+    std::nth_element(SortedPower.begin(), SortedPower.begin() + FftSize / 2, SortedPower.end());
+
+    const float32 DetectionPower{Settings.DetectionRatio * SortedPower[FftSize / 2]};
+
+    std::vector<size_t> CarrierBins{};
+
+    for(size_t Bin{Skimmer::NumDcBins + 1}; Bin < FftSize - Skimmer::NumDcBins; ++Bin)
+    {
+        auto GetNeighbour = [&MeanPower, FftSize, Bin](const int64 Offset) -> float32
+        {
+            return MeanPower[(Bin + FftSize + Offset) % FftSize];
+        };
+
+        //the window spreads a carrier over a few bins, only the strongest of them is kept
+        if(MeanPower[Bin] > DetectionPower && MeanPower[Bin] > GetNeighbour(-1) && MeanPower[Bin] > GetNeighbour(-2) && MeanPower[Bin] >= GetNeighbour(1) && MeanPower[Bin] >= GetNeighbour(2))
+        {
+            CarrierBins.emplace_back(Bin);
+        }
+    }
+
+    //one envelope per carrier, the power of its bin and both neighbours so a carrier between two bins does not flutter
+    std::vector<std::vector<float32>> Envelopes(CarrierBins.size(), std::vector<float32>(NumFrames));
+
+    Skimmer::ParallelFor(NumFrames, [&](const size_t First, const size_t Last) -> void
+    {
+        Skimmer::FFrame Frame{FftSize};
+
+        for(size_t FrameIndex{First}; FrameIndex < Last; ++FrameIndex)
+        {
+            Skimmer::ComputePowerSpectrum(IqAudio, FrameIndex * HopSamples, Window, Transform, Frame);
+
+            for(size_t Carrier{0}; Carrier < CarrierBins.size(); ++Carrier)
+            {
+                const size_t Bin{CarrierBins[Carrier]};
+
+                Envelopes[Carrier][FrameIndex] = std::sqrt(Frame.Power[Bin - 1] + Frame.Power[Bin] + Frame.Power[(Bin + 1) % FftSize]);
+            }
+        }
+    });
+
+    Channels.resize(CarrierBins.size());
+
+    std::atomic<size_t> NextCarrier{0};
+
+    //every carrier is decoded independently, so they are handed out one at a time to whichever worker is free
+    Skimmer::ParallelFor(CarrierBins.size(), [&](size_t, size_t) -> void
+    {
+        for(size_t Carrier{NextCarrier++}; Carrier < CarrierBins.size(); Carrier = NextCarrier++)
+        {
+            const int64 SignedBin{CarrierBins[Carrier] < FftSize / 2 ? static_cast<int64>(CarrierBins[Carrier]) : static_cast<int64>(CarrierBins[Carrier]) - static_cast<int64>(FftSize)};
+
+            Channels[Carrier].FrequencyHz = static_cast<float32>(SignedBin) * static_cast<float32>(IqAudio.SampleRate) / static_cast<float32>(FftSize);
+            Channels[Carrier].PlainText = DecodeEnvelope(Envelopes[Carrier], HopSamples, IqAudio.SampleRate, Settings.InitialWpm);
+        }
+    });
+
+    std::erase_if(Channels, [](const FSkimmerChannel& Channel) -> bool
+    {
+        return Channel.PlainText.empty();
+    });
+
+    std::sort(Channels.begin(), Channels.end(), [](const FSkimmerChannel& Left, const FSkimmerChannel& Right) -> bool
+    {
+        return Left.FrequencyHz < Right.FrequencyHz;
+    });
+
+    return Channels;
+}
+
+std::vector<FSkimmerChannel> DecodeIqToPlainText(const std::string& PathToFile, const uint32 SampleRate, const FSkimmerSettings& Settings)
+{
+    FPcmAudio IqAudio{ReadPcmAudio(PathToFile)};
+
+    if(IsRawPcmPath(PathToFile))
+    {
+        IqAudio.SampleRate = SampleRate;
+        IqAudio.NumChannels = 2;
+    }
+
+    if(IqAudio.Samples.empty())
+    {
+        return std::vector<FSkimmerChannel>{};
+    }
+
+    if(IqAudio.NumChannels != 2)
+    {
+        std::cerr << "IQ recordings have to be stereo: " << PathToFile << std::endl;
+        return std::vector<FSkimmerChannel>{};
+    }
+
+    return DecodeIq(IqAudio, Settings);
+}
+
+void WriteToFile(const std::string& PathToOutFile, const std::vector<FSkimmerChannel>& ChannelsToWrite)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToOutFile, std::ios::out);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToOutFile << std::endl;
+        return;
+    }
+
+    for(const FSkimmerChannel& Channel : ChannelsToWrite)
+    {
+        FStream << std::lround(Channel.FrequencyHz) << " Hz: ";
+        FStream.write(Channel.PlainText.data(), static_cast<std::streamsize>(Channel.PlainText.size()));
+        FStream << "\n";
+    }
+
+    FStream.close();
+}
@@ -0,0 +1,65 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "ToneDecoder.h"
+
+//in-place complex FFT on split real/imaginary arrays, radix-2 with every stage of eight or more butterflies done in float32_8 lanes
+class FFastFourierTransform final
+{
+public:
+
+    explicit FFastFourierTransform(size_t InSize);
+
+    void Forward(float32* Real, float32* Imaginary) const;
+
+    size_t GetSize() const {return Size;}
+
+private:
+
+    size_t Size;
+
+    std::vector<uint32> BitReversed;
+
+    //stage with half size H uses the H entries starting at H - 1
+    std::vector<float32> TwiddleReal;
+    std::vector<float32> TwiddleImaginary;
+};
+
+struct FSkimmerSettings
+{
+    //a power of two, 2048 at 192 kHz gives 94 Hz channels
+    size_t FftSize{2048};
+
+    //how far the mean power of a channel has to rise above the median channel to count as a carrier
+    float32 DetectionRatio{3.f};
+
+    float32 InitialWpm{0.f};
+};
+
+struct FSkimmerChannel
+{
+    //offset from the centre of the recording
+    float32 FrequencyHz;
+    std::vector<char> PlainText;
+};
+
+//channelizes complex IQ samples (I = first, Q = second channel) with an FFT filter bank,
+//finds every carrier and decodes all of them on a pool of workers
+std::vector<FSkimmerChannel> DecodeIq(const FPcmAudio& IqAudio, const FSkimmerSettings& Settings = {});
+
+//WAV files have to be stereo, .raw/.pcm files are interleaved 16 bit I/Q at SampleRate
+std::vector<FSkimmerChannel> DecodeIqToPlainText(const std::string& PathToFile, uint32 SampleRate, const FSkimmerSettings& Settings = {});
+
+//one "<Frequency> Hz: <Text>" line per channel
+void WriteToFile(const std::string& PathToOutFile, const std::vector<FSkimmerChannel>& ChannelsToWrite);
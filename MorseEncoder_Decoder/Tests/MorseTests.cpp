@@ -0,0 +1,1152 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+//a self-contained test driver, built from this directory next to the other translation units (tiff.h comes with the libtiff headers):
+//clang++ -std=c++20 -O2 -mavx2 -mfma -mbmi2 -I.. MorseTests.cpp $(ls ../*.cpp | grep -v main.cpp) -lpthread -o MorseTests
+//BMI2 is needed for pext/pdep. g++ does not build the integer FusedMultiplyAdd specializations in
+//Simd_Library-main/SimdRegisterLibrary.h, they rely on clang's implicit vector conversions
+//prints every failed expectation and returns 1 if there was one
+
+#include "../NoisyDecoder.h"
+#include "../AudioRenderer.h"
+#include "../LiveAudioDecoder.h"
+#include "../MorseValidator.h"
+#include "../MorseSearch.h"
+#include "../WordIndex.h"
+#include "../RangeDecoder.h"
+#include "../MorseRanges.h"
+#include "../MorseApi.h"
+#include "../MorseNotation.h"
+#include "../MorseAlphabet.h"
+#include "../MorseSink.h"
+#include "../PackedMorse.h"
+#include <filesystem>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Tests
+{
+    struct FTestCase
+    {
+        const char* Name;
+        std::function<void()> Run;
+    };
+
+    int32 NumFailed{0};
+
+    void Expect(const bool bCondition, const char* Expression, const char* File, const int32 Line)
+    {
+        if(!bCondition)
+        {
+            std::cerr << File << ":" << Line << ": expected " << Expression << std::endl;
+            ++NumFailed;
+        }
+    }
+
+    //the file interfaces take paths, so inputs go through a scratch file that is rewritten by every call
+    std::string WriteTempFile(const std::string_view Contents, const std::string& Name = "MorseTests.tmp")
+    {
+        const std::string PathToFile{(std::filesystem::temp_directory_path() / Name).string()};
+
+        std::fstream FStream{PathToFile, std::ios::out | std::ios::binary | std::ios::trunc};
+        FStream.write(Contents.data(), static_cast<std::streamsize>(Contents.size()));
+
+        return PathToFile;
+    }
+
+    template<typename ContainerType>
+    std::string ToString(const ContainerType& Container)
+    {
+        return std::string{Container.begin(), Container.end()};
+    }
+
+    //Read gets the path of a FIFO a second thread writes Contents into, which cannot seek like a file.
+    //Contents stays below the pipe buffer, so the writer finishes even when the reader stops early
+    template<typename ReadType>
+    auto ReadFromPipe(const std::string& Contents, ReadType Read)
+    {
+        const std::filesystem::path Path{std::filesystem::temp_directory_path() / "MorseTests.fifo"};
+
+        std::filesystem::remove(Path);
+        mkfifo(Path.c_str(), 0600);
+
+        std::thread Writer{[&Path, &Contents]() -> void
+        {
+            std::ofstream{Path, std::ios::binary} << Contents;
+        }};
+
+        auto Result{Read(Path.string())};
+        Writer.join();
+
+        return Result;
+    }
+
+    //the native writer's output of a text
+    std::string Encode(const std::string_view PlainText)
+    {
+        const std::string PathToFile{WriteTempFile(PlainText)};
+        const std::string PathToOutFile{PathToFile + ".out"};
+
+        WriteToFile(PathToOutFile, EncodePlainTextToMorse(PathToFile));
+
+        std::fstream FStream{PathToOutFile, std::ios::in | std::ios::binary};
+        return std::string{std::istreambuf_iterator<char>{FStream}, std::istreambuf_iterator<char>{}};
+    }
+}
+
+#define EXPECT(Expression) Tests::Expect((Expression), #Expression, __FILE__, __LINE__)
+
+namespace Tests
+{
+    void NoisyDecoderKeepsCleanInput()
+    {
+        const FCharacterLanguageModel LanguageModel{};
+        const FNoisyMorseDecoder Decoder{LanguageModel};
+
+        for(const std::string_view PlainText : {"THE QUICK BROWN FOX", "SOS PARIS 12345 67890"})
+        {
+            const std::string MorseText{Encode(PlainText)};
+
+            EXPECT(ToString(Decoder.Decode(std::vector<char>{MorseText.begin(), MorseText.end()}).PlainText) == PlainText);
+        }
+    }
+
+    void NoisyDecoderRepairsFlippedElement()
+    {
+        const FCharacterLanguageModel LanguageModel{};
+        const FNoisyMorseDecoder Decoder{LanguageModel};
+
+        //six longs are no symbol, a flipped element costs less than splitting them at an invented separator
+        const std::string MorseText{"------&"};
+
+        EXPECT(Decoder.Decode(std::vector<char>{MorseText.begin(), MorseText.end()}).PlainText.size() == 1);
+    }
+
+    void NoisyDecoderCommitsLongInput()
+    {
+        const FCharacterLanguageModel LanguageModel{};
+        const FNoisyMorseDecoder Decoder{LanguageModel};
+
+        std::string PlainText{};
+
+        for(size_t Repeat{0}; Repeat < 200; ++Repeat)
+        {
+            PlainText += Repeat == 0 ? "" : " ";
+            PlainText += "THE QUICK BROWN FOX JUMPS OVER 13 LAZY DOGS";
+        }
+
+        //tens of thousands of elements, so the shared prefix is written out and the history dropped many times over
+        const std::string MorseText{Encode(PlainText)};
+        const std::string PathToFile{WriteTempFile(MorseText, "noisy_long.txt")};
+
+        const FNoisyDecodeResult FromFile{Decoder.Decode(PathToFile)};
+
+        EXPECT(ToString(FromFile.PlainText) == PlainText);
+        EXPECT(FromFile.Confidence.size() == PlainText.size());
+
+        EXPECT(ToString(Decoder.Decode(std::vector<char>{MorseText.begin(), MorseText.end()}).PlainText) == PlainText);
+    }
+
+    void EncoderSeparatesCharactersAndWords()
+    {
+        EXPECT(Encode("AB") == "*-&-***&");
+
+        //a word space replaces the separator in front of it, runs of spaces are one word space
+        EXPECT(Encode("AB ") == "*-&-***|");
+        EXPECT(Encode("A  B") == "*-|-***&");
+
+        //characters without a code keep their separator
+        EXPECT(Encode("A\nB") == "*-&&-***&");
+        EXPECT(Encode("A<SK>") == "*-&***-*-&");
+        EXPECT(Encode("").empty());
+    }
+
+    void AlphabetCodesAreDistinct()
+    {
+        std::vector<uint16> PackedCodes{};
+
+        for(const char Character : MorseCodes::Alphabet)
+        {
+            const uint16 PackedCode{PackMorseCode(GetMorseFromCharacter(Character))};
+
+            EXPECT(PackedCode != 0);
+            EXPECT(GetCharacterFromPackedMorse(PackedCode) == Character);
+
+            PackedCodes.emplace_back(PackedCode);
+        }
+
+        std::sort(PackedCodes.begin(), PackedCodes.end());
+        EXPECT(std::adjacent_find(PackedCodes.begin(), PackedCodes.end()) == PackedCodes.end());
+
+        //---.. and ----. with a leading sentinel bit
+        EXPECT(PackMorseCode(GetMorseFromCharacter('8')) == 0b111100);
+        EXPECT(PackMorseCode(GetMorseFromCharacter('9')) == 0b111110);
+    }
+
+    void LoadedAlphabetsReportConflictsAndCache()
+    {
+        auto DecodeWith = [](const std::string_view MorseText, const FMorseAlphabet& Alphabet) -> std::string
+        {
+            const std::vector<char> PlainText{DecodeMorseToPlainText(WriteTempFile(MorseText), Alphabet)};
+            return std::string{PlainText.begin(), PlainText.end()};
+        };
+
+        const std::string PathToFile{WriteTempFile("// a test alphabet\nЖ ...-\nA .-\nB -...\n", "MorseTests.alphabet")};
+        std::filesystem::remove(PathToFile + ".cache");
+
+        FMorseAlphabet Alphabet{};
+        EXPECT(LoadMorseAlphabet(PathToFile, Alphabet));
+        EXPECT(std::filesystem::exists(PathToFile + ".cache"));
+        EXPECT(DecodeWith("***-&*-|-***&---&", Alphabet) == "ЖA B#");
+        EXPECT(Alphabet.Encode('a') == Alphabet.Encode('A'));
+
+        //an unchanged size and write time reads the cache, even though B was redefined
+        const std::filesystem::file_time_type WriteTime{std::filesystem::last_write_time(PathToFile)};
+        WriteTempFile("// a test alphabet\nЖ ...-\nA .-\nB -..-\n", "MorseTests.alphabet");
+        std::filesystem::last_write_time(PathToFile, WriteTime);
+
+        FMorseAlphabet Cached{};
+        EXPECT(LoadMorseAlphabet(PathToFile, Cached));
+        EXPECT(Cached.EncodeTable == Alphabet.EncodeTable && Cached.DecodeTable == Alphabet.DecodeTable && Cached.Texts == Alphabet.Texts);
+        EXPECT(Cached.WideEncodeTable == Alphabet.WideEncodeTable);
+        EXPECT(DecodeWith("-***&-**-&", Cached) == "B#");
+
+        //a new write time compiles it again
+        std::filesystem::last_write_time(PathToFile, WriteTime + std::chrono::seconds{1});
+
+        FMorseAlphabet Recompiled{};
+        EXPECT(LoadMorseAlphabet(PathToFile, Recompiled));
+        EXPECT(DecodeWith("-***&-**-&", Recompiled) == "#B");
+
+        //every conflict is reported with its line, the alphabet passed in is left as it was
+        WriteTempFile("A .-\nA -.\nE .-\nX .x\nY ---------------\nZ - -\n", "MorseTests.alphabet");
+
+        std::ostringstream Errors{};
+        std::streambuf* const ErrorBuffer{std::cerr.rdbuf(Errors.rdbuf())};
+        EXPECT(!LoadMorseAlphabet(PathToFile, Recompiled));
+        std::cerr.rdbuf(ErrorBuffer);
+
+        for(const char* Line : {":2: ", ":3: ", ":4: ", ":5: ", ":6: "})
+        {
+            EXPECT(Errors.str().find(PathToFile + Line) != std::string::npos);
+        }
+
+        EXPECT(Errors.str().find(PathToFile + ":1: ") == std::string::npos);
+        EXPECT(DecodeWith("-***&-**-&", Recompiled) == "#B");
+
+        std::filesystem::remove(PathToFile + ".cache");
+    }
+
+    void WideCharactersEncodeThroughPages()
+    {
+        auto EncodeWith = [](const std::string& PlainText, const FMorseAlphabet& Alphabet) -> std::string
+        {
+            std::string MorseText{};
+            TContainerSink<std::string> Sink{MorseText};
+            WriteValidElements(EncodePlainTextToMorse(WriteTempFile(PlainText), Alphabet), Sink);
+
+            return MorseText;
+        };
+
+        const FMorseAlphabet Cyrillic{FMorseAlphabet::Cyrillic()};
+
+        EXPECT(EncodeWith("Жж Ёё", Cyrillic) == "***-&***-|*&*&");
+        EXPECT(Cyrillic.WideEncodeTable.Get(U'Я') == (std::array<uint16, 2>{0b10101, 0}));
+
+        //voiced kana take two codes, hiragana the codes of their katakana
+        const FMorseAlphabet Wabun{FMorseAlphabet::Wabun()};
+
+        EXPECT(EncodeWith("ガ", Wabun) == EncodeWith("カ゛", Wabun));
+        EXPECT(EncodeWith("が", Wabun) == EncodeWith("ガ", Wabun) && !EncodeWith("が", Wabun).empty());
+
+        //code points on pages without codes, up to the last one, are left out
+        EXPECT(EncodeWith("\xF0\x9F\x98\x80Ж\xF4\x8F\xBF\xBF", Cyrillic) == "***-&");
+        EXPECT(Wabun.WideEncodeTable.Get(0x10FFFF) == (std::array<uint16, 2>{}));
+
+        //the national alphabets only allocate the page their letters are on next to the empty one, kana and their punctuation share one
+        EXPECT(Cyrillic.WideEncodeTable.Pages.size() == 2);
+        EXPECT(Wabun.WideEncodeTable.Pages.size() == 2);
+    }
+
+    void ProsignsDecodeByName()
+    {
+        EXPECT(GetTextFromPackedMorse(GetPackedMorseFromProsign("SK")) == "<SK>");
+        EXPECT(GetTextFromPackedMorse(GetPackedMorseFromProsign("SOS")) == "<SOS>");
+
+        //AR shares its code with +
+        EXPECT(GetTextFromPackedMorse(GetPackedMorseFromProsign("AR")) == "+");
+        EXPECT(GetPackedMorseFromProsign("XX") == 0);
+    }
+
+    void ValidatorReportsErrorsAtTheirOffsets()
+    {
+        //x is invalid, the code after it has ten elements
+        const FValidationResult Result{ValidateMorseText(WriteTempFile("*-&x&*-*-*-*-*-&"), EValidationPolicy::Report)};
+
+        EXPECT(Result.Errors.size() == 2);
+        EXPECT(Result.Errors.size() == 2 && Result.Errors[0].ByteOffset == 3 && Result.Errors[0].Kind == EMorseError::InvalidByte);
+        EXPECT(Result.Errors.size() == 2 && Result.Errors[1].ByteOffset == 5 && Result.Errors[1].Kind == EMorseError::OverlongCode);
+
+        EXPECT(ValidateMorseText(WriteTempFile("*-&x&x"), EValidationPolicy::Strict).Errors.size() == 1);
+    }
+
+    void ValidatorIgnoresBlanksLikeTheDecoder()
+    {
+        //wrapped and CRLF text is valid, a code split by a line break is still one code
+        std::string MorseText{};
+
+        for(size_t Line{0}; Line < 40; ++Line)
+        {
+            MorseText += "****&*&*-**&*-**&---|*--&---&*-*&*-**&-**|\r\n";
+        }
+
+        EXPECT(ValidateMorseText(WriteTempFile(MorseText), EValidationPolicy::Report).Errors.empty());
+        EXPECT(ValidateMorseText(WriteTempFile("*-*-*\n-*-*-&"), EValidationPolicy::Report).Errors.size() == 1);
+        EXPECT(ValidateMorseText(WriteTempFile("*-*-*\n-*-*&"), EValidationPolicy::Report).Errors.empty());
+    }
+
+    void ValidatorMatchesAByteAtATimeCheck()
+    {
+        //the errors as a byte at a time walk finds them, blanks skipped
+        auto FindErrors = [](const std::string& MorseText) -> std::vector<std::pair<uint64, EMorseError>>
+        {
+            std::vector<std::pair<uint64, EMorseError>> Errors{};
+            uint64 NumCodeBytes{0};
+            uint64 CodeStart{0};
+
+            for(uint64 Offset{0}; Offset < MorseText.size(); ++Offset)
+            {
+                const char Character{MorseText[Offset]};
+
+                if(Character == '&' || Character == '|')
+                {
+                    NumCodeBytes = 0;
+                }
+                else if(Character != ' ' && Character != '\t' && Character != '\r' && Character != '\n')
+                {
+                    CodeStart = NumCodeBytes == 0 ? Offset : CodeStart;
+
+                    if(++NumCodeBytes == MorseCodes::MaxSymbolElements + 1)
+                    {
+                        Errors.emplace_back(CodeStart, EMorseError::OverlongCode);
+                    }
+                    if(Character != '*' && Character != '-')
+                    {
+                        Errors.emplace_back(Offset, EMorseError::InvalidByte);
+                    }
+                }
+            }
+
+            std::stable_sort(Errors.begin(), Errors.end(), [](const auto& A, const auto& B) -> bool {return A.first < B.first;});
+            return Errors;
+        };
+
+        //mostly elements, so long codes run across blanks and block boundaries
+        std::mt19937 Random{7};
+        const std::string_view Bytes{"*-*-*-*-*-*-**--&&|  \n\r\tx"};
+
+        for(uint32 Round{0}; Round < 200; ++Round)
+        {
+            std::string MorseText(Random() % 400, ' ');
+
+            for(char& Character : MorseText)
+            {
+                Character = Bytes[Random() % (Round % 2 == 0 ? Bytes.size() - 1 : Bytes.size())];
+            }
+
+            std::vector<std::pair<uint64, EMorseError>> Errors{};
+
+            for(const FMorseError& Error : ValidateMorseText(WriteTempFile(MorseText), EValidationPolicy::Report).Errors)
+            {
+                Errors.emplace_back(Error.ByteOffset, Error.Kind);
+            }
+
+            EXPECT(Errors == FindErrors(MorseText));
+        }
+    }
+
+    void ValidatorSkipDropsOnlyBadCodes()
+    {
+        const FValidationResult Result{ValidateMorseText(WriteTempFile("*-&*x&-***|*-*-*-*-*-&*-"), EValidationPolicy::Skip)};
+
+        //the invalid byte goes and its code stays, the over-long code goes with its separator
+        EXPECT(ToString(Result.MorseText) == "*-&*&-***|*-");
+
+        //the first 64 byte block has a line break and ends exactly on a separator, the error in the next one sends it down the byte path
+        const FValidationResult Aligned{ValidateMorseText(WriteTempFile(std::string(60, ' ') + "*\n*&" + "-**-&x&"), EValidationPolicy::Skip)};
+        std::string Stripped{};
+
+        for(const char Character : Aligned.MorseText)
+        {
+            if(Character != ' ' && Character != '\n')
+            {
+                Stripped.push_back(Character);
+            }
+        }
+
+        EXPECT(Stripped == "**&-**-&");
+    }
+
+    void SearchSkipsLineBreaks()
+    {
+        //long enough for the wrapped file to cross a read chunk
+        std::string PlainText{};
+
+        while(PlainText.size() < 1'000'000)
+        {
+            PlainText += "PARIS SOS HELP ";
+        }
+
+        const std::string MorseText{Encode(PlainText)};
+        std::string Wrapped{};
+
+        for(size_t Start{0}; Start < MorseText.size(); Start += 61)
+        {
+            Wrapped += MorseText.substr(Start, 61) + "\r\n";
+        }
+
+        const std::vector<FMorseMatch> Expected{SearchMorse(WriteTempFile(MorseText), "SOS HELP")};
+        const std::vector<FMorseMatch> Matches{SearchMorse(WriteTempFile(Wrapped), "SOS HELP")};
+
+        EXPECT(Expected.size() == PlainText.size() / 15);
+        EXPECT(Matches.size() == Expected.size());
+
+        //PARIS ends five characters in front of every match
+        EXPECT(!Expected.empty() && Expected.front().CharacterOffset == 5 && Expected.back().CharacterOffset == Expected.size() * 12 - 7);
+
+        for(size_t Match{0}; Match < std::min(Matches.size(), Expected.size()); ++Match)
+        {
+            const uint64 ByteOffset{Expected[Match].ByteOffset};
+
+            //two bytes of line break after every 61 morse bytes
+            EXPECT(Matches[Match].CharacterOffset == Expected[Match].CharacterOffset);
+            EXPECT(Matches[Match].ByteOffset == ByteOffset + ByteOffset / 61 * 2);
+        }
+    }
+
+    void WordIndexCountsLikeTheDecoder()
+    {
+        //"SOS HELP SOS", wrapped with CRLF, and a byte that is no element in the code of the last L
+        const std::string MorseText{"***&---&***|****&*&*-**&*--*|\r\n***&---&***|*-x**&*&"};
+        const std::string PathToIndex{(std::filesystem::temp_directory_path() / "MorseTests.mwix").string()};
+
+        WriteToFile(PathToIndex, BuildWordIndex(WriteTempFile(MorseText)));
+
+        const FMappedWordIndex Index{PathToIndex};
+
+        EXPECT(Index.IsValid());
+        EXPECT(Index.Find("sos") == (std::vector<uint64>{0, 7}));
+        EXPECT(Index.Find("help") == std::vector<uint64>{3});
+
+        //the damaged code of L ends a word instead of being read as L, the character after it starts the next
+        EXPECT(Index.Find("LE").empty());
+        EXPECT(Index.Find("E") == std::vector<uint64>{11});
+    }
+
+    void WordIndexRejectsDamagedFiles()
+    {
+        const std::string PathToIndex{(std::filesystem::temp_directory_path() / "MorseTests.mwix").string()};
+
+        WriteToFile(PathToIndex, BuildWordIndex(WriteTempFile(Encode("SOS HELP SOS"))));
+
+        std::string Contents{};
+        {
+            std::ifstream FStream{PathToIndex, std::ios::binary};
+            Contents.assign(std::istreambuf_iterator<char>{FStream}, std::istreambuf_iterator<char>{});
+        }
+
+        auto IsValidWith = [&PathToIndex](const std::string& Bytes) -> bool
+        {
+            std::ofstream{PathToIndex, std::ios::binary} << Bytes;
+
+            return FMappedWordIndex{PathToIndex}.IsValid();
+        };
+
+        EXPECT(IsValidWith(Contents));
+
+        //NumWords sits after the magic
+        std::string TooManyWords{Contents};
+        TooManyWords[7] = '\x7F';
+        EXPECT(!IsValidWith(TooManyWords));
+
+        //the posting lists are cut short
+        EXPECT(!IsValidWith(Contents.substr(0, Contents.size() - 1)));
+
+        //the word of the first entry points past the words
+        std::string BadWordOffset{Contents};
+        BadWordOffset[sizeof(FWordIndexHeader) + 16] = '\x40';
+        EXPECT(!IsValidWith(BadWordOffset));
+    }
+
+    void RangesDecodeLikeDecode()
+    {
+        //wrapped and indented, with bytes of no symbol and an over-long code
+        std::string MorseText{};
+
+        for(uint32 Line{0}; Line < 40; ++Line)
+        {
+            MorseText += Encode("CQ DE <SK> 73 " + std::to_string(Line)) + (Line % 3 == 0 ? "\r\n  " : "\n") + (Line % 7 == 0 ? "*x-&----------------&" : "");
+        }
+
+        const std::string PathToFile{WriteTempFile(MorseText)};
+        const std::string Decoded{ToString(DecodeMorseToPlainText(PathToFile))};
+
+        EXPECT(Decoded.find('#') != std::string::npos);
+        EXPECT(ToString(DecodeMorseByteRangeToPlainText(PathToFile, 0, MorseText.size())) == Decoded);
+        EXPECT(ToString(DecodeMorseCharacterRangeToPlainText(PathToFile, 0, std::numeric_limits<uint64>::max())) == Decoded);
+
+        //back to back windows of every size decode every character exactly once
+        for(uint64 NumBytes{1}; NumBytes <= 70; NumBytes += NumBytes < 40 ? 1 : 7)
+        {
+            std::string Pages{};
+
+            for(uint64 FirstByte{0}; FirstByte < MorseText.size(); FirstByte += NumBytes)
+            {
+                Pages += ToString(DecodeMorseByteRangeToPlainText(PathToFile, FirstByte, NumBytes));
+            }
+
+            EXPECT(Pages == Decoded);
+        }
+
+        for(uint64 NumCharacters{1}; NumCharacters <= 40; ++NumCharacters)
+        {
+            std::string Pages{};
+
+            for(uint64 FirstCharacter{0}; FirstCharacter * 2 < MorseText.size(); FirstCharacter += NumCharacters)
+            {
+                Pages += ToString(DecodeMorseCharacterRangeToPlainText(PathToFile, FirstCharacter, NumCharacters));
+            }
+
+            EXPECT(Pages == Decoded);
+        }
+
+        //the second word with the space its | ends in, and nothing starts in the last byte
+        EXPECT(ToString(DecodeMorseCharacterRangeToPlainText(PathToFile, 2, 2)) == "DE ");
+        EXPECT(ToString(DecodeMorseByteRangeToPlainText(PathToFile, MorseText.size() - 1, 100)).empty());
+    }
+
+    void PackedMorseRoundTrips()
+    {
+        std::mt19937 Random{7};
+        std::string LongMorseText{};
+
+        //several blocks, ending mid word, with line breaks the packer drops
+        for(size_t Line{0}; LongMorseText.size() < 300000; ++Line)
+        {
+            std::string PlainText{};
+
+            for(size_t Character{0}; Character < 60; ++Character)
+            {
+                PlainText += Random() % 6 == 0 ? ' ' : MorseCodes::Alphabet[Random() % MorseCodes::Alphabet.size()];
+            }
+
+            LongMorseText += Encode(PlainText) + (Line % 2 == 0 ? "\n" : "\r\n ");
+        }
+
+        LongMorseText += "*-*";
+
+        const std::vector<std::string> MorseTexts{"", "*", "|", Encode("SOS"), "*-&\n-***&  |--&", "----------------&*&", LongMorseText};
+
+        for(const std::string& MorseText : MorseTexts)
+        {
+            std::string Expected{MorseText};
+            std::erase_if(Expected, [](const char Character) { return Character != '*' && Character != '-' && Character != '&' && Character != '|'; });
+
+            const FPackedMorse Packed{PackMorseText(WriteTempFile(MorseText))};
+
+            EXPECT(Packed.Header.NumSymbols == Expected.size());
+            EXPECT(Packed.Header.NumCharacters == static_cast<uint64>(std::count_if(Expected.begin(), Expected.end(), [](const char Character) { return Character == '&' || Character == '|'; })));
+            EXPECT(Packed.Header.NumBlocks == (Expected.size() + Packed.Header.SymbolsPerBlock - 1) / Packed.Header.SymbolsPerBlock);
+            EXPECT(Packed.Index.size() == Packed.Header.NumBlocks);
+
+            const std::string PathToPacked{(std::filesystem::temp_directory_path() / "MorseTests.packed.tmp").string()};
+            WriteToFile(PathToPacked, Packed);
+
+            EXPECT(ToString(UnpackMorseText(PathToPacked)) == Expected);
+        }
+
+        EXPECT(PackMorseText(WriteTempFile(LongMorseText)).Header.NumBlocks >= 3);
+    }
+
+    void PackedMorseDecodesFromAnyCharacter()
+    {
+        //single byte characters only, so every character of the decoded text is one character of the file
+        std::mt19937 Random{11};
+        std::string PlainText{};
+
+        for(size_t Word{0}; PlainText.size() < 60000; ++Word)
+        {
+            PlainText += Word == 0 ? "" : " ";
+
+            for(size_t Character{Random() % 8 + 1}; Character > 0; --Character)
+            {
+                PlainText += "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"[Random() % 36];
+            }
+        }
+
+        const FPackedMorse Packed{PackMorseText(WriteTempFile(Encode(PlainText)))};
+        const std::string PathToPacked{(std::filesystem::temp_directory_path() / "MorseTests.packed.tmp").string()};
+        WriteToFile(PathToPacked, Packed);
+
+        EXPECT(Packed.Header.NumBlocks >= 3);
+        EXPECT(ToString(DecodePackedMorseToPlainText(PathToPacked)) == PlainText);
+
+        std::vector<size_t> Starts{};
+
+        for(size_t Offset{0}; Offset < PlainText.size(); ++Offset)
+        {
+            if(PlainText[Offset] != ' ')
+            {
+                Starts.emplace_back(Offset);
+            }
+        }
+
+        EXPECT(Starts.size() == Packed.Header.NumCharacters);
+
+        std::vector<uint64> FirstCharacters{0, Starts.size() - 1};
+
+        //the characters around every block boundary
+        for(size_t Block{1}; Block < Packed.Index.size(); ++Block)
+        {
+            for(const uint64 FirstCharacter : {Packed.Index[Block].FirstCharacter - 1, Packed.Index[Block].FirstCharacter, Packed.Index[Block].FirstCharacter + 1})
+            {
+                FirstCharacters.emplace_back(FirstCharacter);
+            }
+        }
+
+        //characters right after a separator in the last symbol of a packed word, the last word of a block included
+        const size_t WordsPerBlock{Packed.Header.SymbolsPerBlock / 32};
+        uint64 NumCompleted{0};
+        size_t NumAtWordEnd{0};
+        bool bAtBlockEnd{false};
+
+        for(size_t Word{0}; Word < Packed.Words.size(); ++Word)
+        {
+            NumCompleted += static_cast<uint64>(std::popcount(Packed.Words[Word] & 0xAAAAAAAAAAAAAAAA));
+
+            const bool bBlockEnd{Word % WordsPerBlock == WordsPerBlock - 1};
+
+            if(Packed.Words[Word] >> 63 != 0 && NumCompleted < Starts.size() && (NumAtWordEnd < 8 || (bBlockEnd && !bAtBlockEnd)))
+            {
+                FirstCharacters.emplace_back(NumCompleted);
+                ++NumAtWordEnd;
+                bAtBlockEnd |= bBlockEnd;
+            }
+        }
+
+        EXPECT(NumAtWordEnd >= 8);
+
+        //the last character of a word, which comes with the space its | ends in
+        for(size_t Character{0}, NumAtTextWordEnd{0}; Character + 1 < Starts.size() && NumAtTextWordEnd < 8; ++Character)
+        {
+            if(PlainText[Starts[Character] + 1] == ' ')
+            {
+                FirstCharacters.emplace_back(Character);
+                ++NumAtTextWordEnd;
+            }
+        }
+
+        for(const uint64 FirstCharacter : FirstCharacters)
+        {
+            for(const uint64 NumCharacters : {static_cast<uint64>(1), static_cast<uint64>(2), static_cast<uint64>(7), std::numeric_limits<uint64>::max()})
+            {
+                const size_t End{NumCharacters >= Starts.size() - FirstCharacter ? PlainText.size() : Starts[FirstCharacter + NumCharacters]};
+
+                EXPECT(ToString(DecodePackedMorseToPlainText(PathToPacked, FirstCharacter, NumCharacters)) == PlainText.substr(Starts[FirstCharacter], End - Starts[FirstCharacter]));
+            }
+        }
+
+        EXPECT(DecodePackedMorseToPlainText(PathToPacked, Starts.size(), 1).empty());
+    }
+
+    void EncodeCoderWritesLikeEncode()
+    {
+        const std::vector<std::string> PlainTexts
+        {
+            "SOS HELP <SK>",
+            " leading  and trailing spaces ",
+            "no code: ~ at\nline ends\r\n",
+            "<sos><SoS> <AR><XY> <> <SOSS> <S",
+            "PARIS<",
+        };
+
+        for(const std::string& PlainText : PlainTexts)
+        {
+            const std::string Expected{Encode(PlainText)};
+
+            //every split of the text into blocks, so prosigns and spaces land on block ends
+            for(size_t NumBlockBytes{1}; NumBlockBytes <= Morse::BlockBytes; ++NumBlockBytes)
+            {
+                Morse::FEncodeCoder Coder{};
+                std::string MorseText{};
+                std::array<char, Morse::FEncodeCoder::MaxOutputBytes> Output{};
+
+                for(size_t Block{0}; Block <= PlainText.size(); Block += NumBlockBytes)
+                {
+                    std::string Input{PlainText.substr(Block, NumBlockBytes)};
+                    const bool bLast{Block + NumBlockBytes > PlainText.size()};
+
+                    MorseText.append(Output.data(), Coder.Process(Input.data(), Input.size(), bLast, Output.data()));
+
+                    if(bLast)
+                    {
+                        break;
+                    }
+                }
+
+                EXPECT(MorseText == Expected);
+            }
+
+            std::string Viewed{};
+
+            for(const char Character : PlainText | Morse::Encode)
+            {
+                Viewed.push_back(Character);
+            }
+
+            EXPECT(Viewed == Expected);
+        }
+    }
+
+    void ApiEncodesLikeEncode()
+    {
+        const std::string PlainText{"SOS HELP <SK>"};
+        std::vector<char> MorseText(morse_encode_bound(PlainText.size()));
+        size_t NumMorse{0};
+
+        EXPECT(morse_encode(PlainText.data(), PlainText.size(), MorseText.data(), MorseText.size(), &NumMorse) == MORSE_OK);
+        EXPECT(std::string(MorseText.data(), NumMorse) == Encode(PlainText));
+
+        std::vector<char> Decoded(morse_decode_bound(NumMorse));
+        size_t NumDecoded{0};
+
+        EXPECT(morse_decode(MorseText.data(), NumMorse, Decoded.data(), Decoded.size(), &NumDecoded) == MORSE_OK);
+        EXPECT(std::string(Decoded.data(), NumDecoded) == "SOS HELP <SK>");
+
+        EXPECT(morse_encode(nullptr, 1, MorseText.data(), MorseText.size(), &NumMorse) == MORSE_ERROR_INVALID_ARGUMENT);
+        EXPECT(morse_encode(PlainText.data(), PlainText.size(), MorseText.data(), MorseText.size(), nullptr) == MORSE_ERROR_INVALID_ARGUMENT);
+    }
+
+    void ApiReportsTheSizeItNeeds()
+    {
+        std::string PlainText{};
+
+        while(PlainText.size() < 1000)
+        {
+            PlainText += "THE QUICK BROWN FOX <AR> ";
+        }
+
+        const std::string Expected{Encode(PlainText)};
+
+        //too small anywhere from the first block to the last byte
+        for(const size_t OutCap : {size_t{0}, size_t{10}, Expected.size() / 2, Expected.size() - 1})
+        {
+            std::vector<char> MorseText(OutCap);
+            size_t NumMorse{0};
+
+            EXPECT(morse_encode(PlainText.data(), PlainText.size(), MorseText.data(), OutCap, &NumMorse) == MORSE_ERROR_BUFFER_TOO_SMALL);
+            EXPECT(NumMorse == Expected.size());
+        }
+
+        std::vector<char> MorseText(Expected.size());
+        size_t NumMorse{0};
+
+        EXPECT(morse_encode(PlainText.data(), PlainText.size(), MorseText.data(), MorseText.size(), &NumMorse) == MORSE_OK);
+        EXPECT(std::string(MorseText.data(), NumMorse) == Expected);
+    }
+
+    void ApiStreamsInPieces()
+    {
+        const std::string PlainText{"CQ CQ DE <SOS> PARIS <KN>  73 THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 1234567890 <S"};
+        const std::string Expected{Encode(PlainText)};
+
+        morse_stream* Stream{morse_encoder_create()};
+
+        //room for about one block of output, so the input from the block that did not fit has to be passed again
+        std::vector<char> Out(200);
+        std::string MorseText{};
+
+        for(size_t Start{0}, NumPasses{0}; Start < PlainText.size(); ++NumPasses)
+        {
+            size_t NumUsed{0};
+            size_t NumOut{0};
+
+            EXPECT(morse_stream_process(Stream, PlainText.data() + Start, PlainText.size() - Start, &NumUsed, Out.data(), Out.size(), &NumOut) == MORSE_OK);
+            EXPECT(NumUsed > 0 && NumPasses < PlainText.size());
+
+            if(NumUsed == 0)
+            {
+                break;
+            }
+
+            MorseText.append(Out.data(), NumOut);
+            Start += NumUsed;
+        }
+
+        size_t NumOut{0};
+
+        //the held back "<S" does not fit in nothing, the stream keeps it for the next try
+        EXPECT(morse_stream_finish(Stream, Out.data(), 0, &NumOut) == MORSE_ERROR_BUFFER_TOO_SMALL && NumOut == 0);
+        EXPECT(morse_stream_finish(Stream, Out.data(), Out.size(), &NumOut) == MORSE_OK);
+
+        MorseText.append(Out.data(), NumOut);
+        morse_stream_destroy(Stream);
+
+        EXPECT(MorseText == Expected);
+    }
+
+    void StreamWritersMatchTheFileWriters()
+    {
+        //a few sink blocks of output, word spaces and prosigns end up on every block boundary
+        std::string PlainText{};
+
+        for(uint32 Word{0}; PlainText.size() < 20'000; ++Word)
+        {
+            PlainText += std::string(Word % 7 + 1, static_cast<char>('A' + Word % 26)) + (Word % 5 == 0 ? " <SK>  " : " ");
+        }
+
+        const std::string MorseText{Encode(PlainText)};
+
+        std::ostringstream EncodeStream{};
+        EXPECT(EncodePlainTextToStream(WriteTempFile(PlainText), EncodeStream));
+        EXPECT(EncodeStream.str() == MorseText);
+
+        //Unrecognized codes are left out like WriteToFile does
+        const std::string PathToMorse{WriteTempFile(MorseText + "------&*-")};
+        const std::string PathToOutFile{PathToMorse + ".out"};
+
+        WriteToFile(PathToOutFile, DecodeMorseToPlainText(PathToMorse));
+
+        std::ifstream DecodedFile{PathToOutFile, std::ios::binary};
+        const std::string Expected{std::istreambuf_iterator<char>{DecodedFile}, std::istreambuf_iterator<char>{}};
+
+        std::ostringstream DecodeStream{};
+        EXPECT(DecodeMorseToStream(PathToMorse, DecodeStream));
+        EXPECT(DecodeStream.str() == Expected);
+        EXPECT(Expected.size() > PlainText.size() / 2 && Expected.find('#') == std::string::npos);
+
+        EXPECT(!EncodePlainTextToStream(PathToMorse + ".missing", EncodeStream));
+    }
+
+    void SinksWriteLikeTheStreamWriters()
+    {
+        std::string PlainText{};
+
+        for(uint32 Word{0}; PlainText.size() < 40'000; ++Word)
+        {
+            PlainText += std::string(Word % 5 + 1, static_cast<char>('0' + Word % 10)) + (Word % 3 == 0 ? " <AR> " : " ");
+        }
+
+        const std::string PathToText{WriteTempFile(PlainText)};
+        const std::string MorseText{Encode(PlainText)};
+        const std::string PathToMorse{WriteTempFile(MorseText + "&-------&", "MorseTests.morse.tmp")};
+
+        std::ostringstream DecodeStream{};
+        EXPECT(DecodeMorseToStream(PathToMorse, DecodeStream));
+        const std::string PlainTextOut{DecodeStream.str()};
+
+        auto ReadBack = [](const std::string& PathToFile) -> std::string
+        {
+            std::ifstream FStream{PathToFile, std::ios::binary};
+            return std::string{std::istreambuf_iterator<char>{FStream}, std::istreambuf_iterator<char>{}};
+        };
+
+        const std::string PathToOutFile{WriteTempFile("", "MorseTests.sink.out")};
+
+        std::FILE* File{std::fopen(PathToOutFile.c_str(), "wb")};
+        FFileSink FileSink{File};
+        EXPECT(EncodePlainTextToSink(PathToText, FileSink));
+        std::fclose(File);
+        EXPECT(ReadBack(PathToOutFile) == MorseText);
+
+        const int32 Descriptor{::open(PathToOutFile.c_str(), O_WRONLY | O_TRUNC)};
+        FDescriptorSink DescriptorSink{Descriptor};
+        EXPECT(DecodeMorseToSink(PathToMorse, DescriptorSink));
+        ::close(Descriptor);
+        EXPECT(!DescriptorSink.bFailed && ReadBack(PathToOutFile) == PlainTextOut);
+
+        //too small a region keeps what fits and counts the rest
+        std::vector<char> Region(MorseText.size() / 2);
+        FMemorySink MemorySink{Region.data(), Region.size()};
+        EXPECT(EncodePlainTextToSink(PathToText, MemorySink));
+        EXPECT(MemorySink.HasOverflowed() && MemorySink.NumBytes == MorseText.size());
+        EXPECT(std::string_view(Region.data(), Region.size()) == std::string_view(MorseText).substr(0, Region.size()));
+
+        Region.resize(MemorySink.NumBytes);
+        MemorySink = FMemorySink{Region.data(), Region.size()};
+        EXPECT(EncodePlainTextToSink(PathToText, MemorySink));
+        EXPECT(!MemorySink.HasOverflowed() && std::string_view(Region.data(), Region.size()) == MorseText);
+
+        std::string Repaired{};
+        TContainerSink<std::string> ContainerSink{Repaired};
+        EXPECT(DecodeMorseToSink(PathToMorse, ContainerSink, true));
+        EXPECT(Repaired.size() == PlainTextOut.size() + 1 && Repaired.find('#') == std::string::npos);
+
+        EXPECT(!DecodeMorseToSink(PathToMorse + ".missing", ContainerSink));
+    }
+
+    //counts what the overloads taking a resource allocate
+    class FCountingResource final : public std::pmr::memory_resource
+    {
+    public:
+
+        size_t NumAllocations{0};
+
+    private:
+
+        void* do_allocate(const size_t NumBytes, const size_t Alignment) override
+        {
+            ++NumAllocations;
+            return std::pmr::new_delete_resource()->allocate(NumBytes, Alignment);
+        }
+
+        void do_deallocate(void* Pointer, const size_t NumBytes, const size_t Alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(Pointer, NumBytes, Alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& Other) const noexcept override {return this == &Other;}
+    };
+
+    void ResourceOverloadsReserveTheResult()
+    {
+        const std::string PlainText{[]() -> std::string
+        {
+            std::string Text{};
+
+            for(uint32 Word{0}; Text.size() < 100'000; ++Word)
+            {
+                Text += std::string(Word % 6 + 1, static_cast<char>('A' + Word % 26)) + " ";
+            }
+
+            return Text;
+        }()};
+
+        const std::string MorseText{Encode(PlainText)};
+        const std::string PathToMorse{WriteTempFile(MorseText, "MorseTests.morse.tmp")};
+
+        //the result, the read buffer and the output buffer, the result is never grown
+        FCountingResource Resource{};
+        const std::pmr::vector<char> Decoded{DecodeMorseToPlainText(PathToMorse, &Resource)};
+        EXPECT(Resource.NumAllocations == 3);
+        EXPECT(std::string_view(Decoded.data(), Decoded.size()) == PlainText);
+
+        FCountingResource EncodeResource{};
+        const std::pmr::vector<Simd::int16_8> MorseCode{EncodePlainTextToMorse(WriteTempFile(PlainText), &EncodeResource)};
+        EXPECT(EncodeResource.NumAllocations == 3);
+
+        std::string Written{};
+        TContainerSink<std::string> Sink{Written};
+        WriteValidElements(MorseCode, Sink);
+        EXPECT(Written == MorseText);
+
+        //a pipe cannot say how long it is, the result grows as it is read
+        FCountingResource PipeResource{};
+        const std::pmr::vector<char> FromPipe{ReadFromPipe(MorseText, [&PipeResource](const std::string& PathToFile) {return DecodeMorseToPlainText(PathToFile, &PipeResource);})};
+        EXPECT(std::string_view(FromPipe.data(), FromPipe.size()) == PlainText);
+    }
+
+    void TranscoderTranslatesDialects()
+    {
+        auto Transcode = [](const std::string& Text, const FMorseNotation& From, const FMorseNotation& To, const size_t NumPieceBytes) -> std::string
+        {
+            FMorseTranscoder Transcoder{From, To};
+            std::vector<char> OutText{};
+
+            for(size_t Start{0}; Start < Text.size(); Start += NumPieceBytes)
+            {
+                Transcoder.Push(Text.data() + Start, std::min(NumPieceBytes, Text.size() - Start), OutText);
+            }
+
+            Transcoder.Finish(OutText);
+
+            return ToString(OutText);
+        };
+
+        EXPECT(Transcode("****&*&*-**&*-**&---|*--&---&", FMorseNotation::Native(), FMorseNotation::Dots(), 32) == ".... . .-.. .-.. --- / .-- --- ");
+
+        //the longest token wins where " / " and " " both start, bytes of no token are dropped
+        EXPECT(Transcode(".- / -...  x-.-. ", FMorseNotation::Dots(), FMorseNotation::Native(), 32) == "*-|-***&&-*-*&");
+
+        const std::string MorseText{Encode("THE QUICK BROWN FOX <SK> JUMPS OVER 1234567890 LAZY DOGS")};
+
+        //multi byte tokens split across every piece size on the way there and back
+        for(size_t NumPieceBytes{1}; NumPieceBytes <= 13; ++NumPieceBytes)
+        {
+            const std::string UnicodeText{Transcode(MorseText, FMorseNotation::Native(), FMorseNotation::Unicode(), NumPieceBytes)};
+
+            EXPECT(Transcode(UnicodeText, FMorseNotation::Unicode(), FMorseNotation::Native(), NumPieceBytes) == MorseText);
+            EXPECT(Transcode(UnicodeText, FMorseNotation::Unicode(), FMorseNotation::Dots(), NumPieceBytes) == Transcode(MorseText, FMorseNotation::Native(), FMorseNotation::Dots(), 32));
+        }
+
+        const std::string PathToDots{WriteTempFile(Transcode(MorseText, FMorseNotation::Native(), FMorseNotation::Dots(), 32), "MorseTests.dots")};
+        EXPECT(DecodeMorseToPlainText(PathToDots, FMorseNotation::Dots()) == DecodeMorseToPlainText(WriteTempFile(MorseText)));
+
+        FMorseNotation Notation{};
+
+        EXPECT(ParseMorseNotation("dit,dah,_,//", Notation) && Notation.Short == "dit" && Notation.NewWord == "//");
+        EXPECT(!ParseMorseNotation("a,b,a,c", Notation));
+        EXPECT(!ParseMorseNotation("a,b,c", Notation));
+        EXPECT(!ParseMorseNotation("a,b,,c", Notation));
+    }
+
+    void DottedTextEndsCharactersAtLineEnds()
+    {
+        auto DecodeDots = [](const std::string& MorseText, const FMorseNotation& Notation) -> std::string
+        {
+            return ToString(DecodeMorseToPlainText(WriteTempFile(MorseText, "MorseTests.dots"), Notation));
+        };
+
+        //the last character has no separator after it
+        EXPECT(DecodeDots(".... . .-.. .-.. ---", FMorseNotation::Dots()) == "HELLO");
+        EXPECT(DecodeDots(".-", FMorseNotation::Dots()) == "A");
+
+        //a line break ends a character, one after a separator adds nothing
+        EXPECT(DecodeDots(".-\n-...", FMorseNotation::Dots()) == "AB");
+        EXPECT(DecodeDots(".-\r\n-...\r\n", FMorseNotation::Dots()) == "AB");
+        EXPECT(DecodeDots(".- / \n-... \n\n-.-.", FMorseNotation::Dots()) == "A BC");
+        EXPECT(DecodeDots("\xC2\xB7\xE2\x88\x92\n\xE2\x88\x92\xC2\xB7", FMorseNotation::Unicode()) == "AN");
+
+        //a dialect with a line break in its tokens keeps it as the token
+        FMorseNotation LineNotation{};
+        EXPECT(ParseMorseNotation(".,-,\n, / ", LineNotation));
+        EXPECT(DecodeDots(".-\n-... / -.-.", LineNotation) == "AB C");
+
+        //one character a line, past the read chunk so lines are cut by chunk boundaries too
+        const std::string_view Letters{"THEQUICKBROWNFOXJUMPSOVERTHELAZYDOG0123456789"};
+        std::string Lines{};
+
+        for(const char Character : Letters)
+        {
+            for(const char Element : Encode(std::string(1, Character)))
+            {
+                Lines += Element == '*' ? "." : Element == '-' ? "-" : "";
+            }
+
+            Lines += "\n";
+        }
+
+        std::string Wrapped{};
+        std::string Expected{};
+
+        while(Wrapped.size() < 3 << 20)
+        {
+            Wrapped += Lines;
+            Expected += Letters;
+        }
+
+        EXPECT(DecodeDots(Wrapped, FMorseNotation::Dots()) == Expected);
+    }
+
+    void EncoderAndValidatorReadPipes()
+    {
+        //a prosign name is read ahead without seeking back
+        const std::string PlainText{"PARIS <SK> PARIS 73 <"};
+
+        const std::vector<Simd::int16_8> MorseCode{ReadFromPipe(PlainText, [](const std::string& PathToFile) {return EncodePlainTextToMorse(PathToFile);})};
+        const std::string PathToOutFile{WriteTempFile("", "MorseTests.pipe.out")};
+
+        WriteToFile(PathToOutFile, MorseCode);
+
+        std::ifstream OutFile{PathToOutFile, std::ios::binary};
+        EXPECT(std::string(std::istreambuf_iterator<char>{OutFile}, std::istreambuf_iterator<char>{}) == Encode(PlainText));
+
+        const FValidationResult Result{ReadFromPipe("*-&*x&-***|", [](const std::string& PathToFile) {return ValidateMorseText(PathToFile, EValidationPolicy::Skip);})};
+        EXPECT(ToString(Result.MorseText) == "*-&*&-***|");
+    }
+
+    void LiveAudioDecoderIgnoresLeadingNoise()
+    {
+        const FPcmAudio Signal{FMorseAudioRenderer{FToneSettings{}}.RenderText("CQ CQ DE TEST")};
+
+        std::mt19937 Random{1};
+        std::normal_distribution<float32> Noise{0.f, 1500.f};
+
+        //half a second of noise in front of the first character
+        std::vector<int16> Samples(FLiveAudioDecoder::DefaultSampleRate / 2);
+
+        for(int16& Sample : Samples)
+        {
+            Sample = static_cast<int16>(Noise(Random));
+        }
+
+        for(const int16 Sample : Signal.Samples)
+        {
+            Samples.emplace_back(static_cast<int16>(std::clamp(static_cast<float32>(Sample) + Noise(Random), -32768.f, 32767.f)));
+        }
+
+        FLiveAudioDecoder Decoder{FLiveAudioDecoder::DefaultSampleRate, FLiveAudioDecoder::DefaultToneFrequency};
+        std::string PlainText{};
+
+        auto Append = [&PlainText](const char Character, uint64) -> void
+        {
+            PlainText.push_back(Character);
+        };
+
+        Decoder.PushSamples(Samples.data(), Samples.size(), Append);
+        Decoder.Finish(Append);
+
+        EXPECT(PlainText == "CQ CQ DE TEST");
+    }
+
+    const std::vector<FTestCase> TestCases
+    {
+        {"NoisyDecoderKeepsCleanInput", NoisyDecoderKeepsCleanInput},
+        {"NoisyDecoderRepairsFlippedElement", NoisyDecoderRepairsFlippedElement},
+        {"NoisyDecoderCommitsLongInput", NoisyDecoderCommitsLongInput},
+        {"EncoderSeparatesCharactersAndWords", EncoderSeparatesCharactersAndWords},
+        {"AlphabetCodesAreDistinct", AlphabetCodesAreDistinct},
+        {"LoadedAlphabetsReportConflictsAndCache", LoadedAlphabetsReportConflictsAndCache},
+        {"WideCharactersEncodeThroughPages", WideCharactersEncodeThroughPages},
+        {"ProsignsDecodeByName", ProsignsDecodeByName},
+        {"ValidatorReportsErrorsAtTheirOffsets", ValidatorReportsErrorsAtTheirOffsets},
+        {"ValidatorIgnoresBlanksLikeTheDecoder", ValidatorIgnoresBlanksLikeTheDecoder},
+        {"ValidatorMatchesAByteAtATimeCheck", ValidatorMatchesAByteAtATimeCheck},
+        {"ValidatorSkipDropsOnlyBadCodes", ValidatorSkipDropsOnlyBadCodes},
+        {"SearchSkipsLineBreaks", SearchSkipsLineBreaks},
+        {"WordIndexCountsLikeTheDecoder", WordIndexCountsLikeTheDecoder},
+        {"WordIndexRejectsDamagedFiles", WordIndexRejectsDamagedFiles},
+        {"RangesDecodeLikeDecode", RangesDecodeLikeDecode},
+        {"PackedMorseRoundTrips", PackedMorseRoundTrips},
+        {"PackedMorseDecodesFromAnyCharacter", PackedMorseDecodesFromAnyCharacter},
+        {"EncodeCoderWritesLikeEncode", EncodeCoderWritesLikeEncode},
+        {"ApiEncodesLikeEncode", ApiEncodesLikeEncode},
+        {"ApiReportsTheSizeItNeeds", ApiReportsTheSizeItNeeds},
+        {"ApiStreamsInPieces", ApiStreamsInPieces},
+        {"StreamWritersMatchTheFileWriters", StreamWritersMatchTheFileWriters},
+        {"SinksWriteLikeTheStreamWriters", SinksWriteLikeTheStreamWriters},
+        {"ResourceOverloadsReserveTheResult", ResourceOverloadsReserveTheResult},
+        {"TranscoderTranslatesDialects", TranscoderTranslatesDialects},
+        {"DottedTextEndsCharactersAtLineEnds", DottedTextEndsCharactersAtLineEnds},
+        {"EncoderAndValidatorReadPipes", EncoderAndValidatorReadPipes},
+        {"LiveAudioDecoderIgnoresLeadingNoise", LiveAudioDecoderIgnoresLeadingNoise},
+    };
+}
+
+int main()
+{
+    for(const Tests::FTestCase& TestCase : Tests::TestCases)
+    {
+        const int32 NumFailedBefore{Tests::NumFailed};
+
+        TestCase.Run();
+
+        std::cout << (Tests::NumFailed == NumFailedBefore ? "passed " : "FAILED ") << TestCase.Name << std::endl;
+    }
+
+    return Tests::NumFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,377 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ToneDecoder.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <thread>
+
+namespace Tone
+{
+    //candidate frequencies for DetectToneFrequency, LowestCandidate + n * CandidateStep
+    constexpr float32 LowestCandidate{300.f};
+    constexpr float32 CandidateStep{10.f};
+    constexpr size_t NumCandidateRegisters{16};
+
+    constexpr size_t MaxScanWindows{512};
+    constexpr float32 ScanWindowSeconds{0.05f};
+
+    //per block rates of the threshold tracker, the floor drops fast and rises slow so it settles on the noise between elements
+    constexpr float32 FloorFallRate{0.1f};
+    constexpr float32 FloorRiseRate{0.01f};
+    constexpr float32 PeakFollowRate{0.05f};
+    constexpr float32 PeakDecayRate{0.0005f};
+
+    //below this the peak is treated as noise, so silence between transmissions does not key
+    constexpr float32 MinimumPeakToFloor{3.f};
+
+    constexpr float32 KeyDownPoint{0.55f};
+    constexpr float32 KeyUpPoint{0.45f};
+
+    constexpr size_t NumSpeedEstimateElements{512};
+
+    //the threshold is seeded from the levels in the first magnitudes, below the floor quantile is taken as noise
+    constexpr size_t NumSeedMagnitudes{4096};
+    constexpr float32 SeedFloorQuantile{0.3f};
+    constexpr float32 SeedPeakQuantile{0.95f};
+    constexpr float32 FallbackWpm{20.f};
+
+    float32 SumLanes(const Simd::float32_8& Register)
+    {
+        float32 Sum{0.f};
+
+        for(size_t Lane{0}; Lane < Simd::float32_8::GetNumElements(); ++Lane)
+        {
+            Sum += Register[Lane];
+        }
+
+        return Sum;
+    }
+
+    //splits the first key-down durations into dots and dashes with two-means, so the adaptive decoder starts near the real speed
+    //instead of having to drift there from a guess that may classify every gap wrong
+    float32 EstimateWordsPerMinute(const std::vector<uint64>& Transitions)
+    {
+        std::vector<float32> Durations{};
+
+        for(size_t Transition{1}; Transition < Transitions.size() && Durations.size() < NumSpeedEstimateElements; Transition += 2)
+        {
+            Durations.emplace_back(static_cast<float32>(Transitions[Transition] - Transitions[Transition - 1]));
+        }
+
+        if(Durations.empty())
+        {
+            return FallbackWpm;
+        }
+
+        float32 Dot{*std::min_element(Durations.begin(), Durations.end())};
+        float32 Dash{*std::max_element(Durations.begin(), Durations.end())};
+
+        for(size_t Iteration{0}; Iteration < 8; ++Iteration)
+        {
+            const float32 Split{0.5f * (Dot + Dash)};
+
+            std::array<float32, 2> Sums{};
+            std::array<size_t, 2> Counts{};
+
+            for(const float32 Duration : Durations)
+            {
+                Sums[Duration >= Split] += Duration;
+                ++Counts[Duration >= Split];
+            }
+
+            Dot = Counts[0] > 0 ? Sums[0] / static_cast<float32>(Counts[0]) : Dot;
+            Dash = Counts[1] > 0 ? Sums[1] / static_cast<float32>(Counts[1]) : Dash;
+        }
+
+        //a single cluster means only dots or only dashes were seen, which says nothing about the speed
+        if(Dash < 2.f * Dot)
+        {
+            return FallbackWpm;
+        }
+
+        return 1200000.f / (0.5f * (Dot + Dash / 3.f));
+    }
+}
+
+FToneDetector::FToneDetector(const uint32 SampleRate, const float32 ToneFrequency, const float32 BlockSeconds)
+{
+    constexpr size_t NumLanes{Simd::float32_8::GetNumElements()};
+
+    const size_t NumRegisters{std::max<size_t>(1, static_cast<size_t>(std::lround(SampleRate * BlockSeconds / NumLanes)))};
+    const float64 RadiansPerSample{2.0 * std::numbers::pi * ToneFrequency / SampleRate};
+
+    std::array<float32, NumLanes> CosineLanes{};
+    std::array<float32, NumLanes> SineLanes{};
+
+    for(size_t Register{0}; Register < NumRegisters; ++Register)
+    {
+        for(size_t Lane{0}; Lane < NumLanes; ++Lane)
+        {
+            CosineLanes[Lane] = static_cast<float32>(std::cos(RadiansPerSample * (Register * NumLanes + Lane)));
+            SineLanes[Lane] = static_cast<float32>(std::sin(RadiansPerSample * (Register * NumLanes + Lane)));
+        }
+
+        Cosines.emplace_back(_mm256_loadu_ps(CosineLanes.data()));
+        Sines.emplace_back(_mm256_loadu_ps(SineLanes.data()));
+    }
+}
+
+float32 FToneDetector::GetMagnitude(const int16* Block) const
+{
+    constexpr size_t NumLanes{Simd::float32_8::GetNumElements()};
+
+    Simd::float32_8 Real{0.f};
+    Simd::float32_8 Imaginary{0.f};
+
+    for(size_t Register{0}; Register < Cosines.size(); ++Register)
+    {
+        const __m256 Samples{_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Block + Register * NumLanes))))};
+
+        Real = Simd::float32_8{Simd::FusedMultiplyAdd(Samples, Cosines[Register].Register, Real.Register)};
+        Imaginary = Simd::float32_8{Simd::FusedMultiplyAdd(Samples, Sines[Register].Register, Imaginary.Register)};
+    }
+
+    const float32 RealSum{Tone::SumLanes(Real)};
+    const float32 ImaginarySum{Tone::SumLanes(Imaginary)};
+
+    return std::sqrt(RealSum * RealSum + ImaginarySum * ImaginarySum) / static_cast<float32>(GetBlockSamples());
+}
+
+FEnvelopeThreshold::FEnvelopeThreshold(const float32 InitialFloor, const float32 InitialPeak)
+    : Floor(InitialFloor)
+    , Peak(InitialPeak)
+{
+}
+
+bool FEnvelopeThreshold::Update(const float32 Magnitude)
+{
+    //only key-up blocks move the floor and only key-down blocks pull the peak, so neither is dragged by the other state
+    if(!bKeyDown)
+    {
+        Floor += (Magnitude < Floor ? Tone::FloorFallRate : Tone::FloorRiseRate) * (Magnitude - Floor);
+    }
+
+    if(Magnitude > Peak)
+    {
+        Peak = Magnitude;
+    }
+    else if(bKeyDown)
+    {
+        Peak += Tone::PeakFollowRate * (Magnitude - Peak);
+    }
+    else
+    {
+        Peak += Tone::PeakDecayRate * (Floor - Peak);
+    }
+
+    if(Peak < Tone::MinimumPeakToFloor * Floor)
+    {
+        bKeyDown = false;
+        return bKeyDown;
+    }
+
+    bKeyDown = Magnitude > Floor + (bKeyDown ? Tone::KeyUpPoint : Tone::KeyDownPoint) * (Peak - Floor);
+
+    return bKeyDown;
+}
+
+FEnvelopeThreshold MakeSeededThreshold(const std::span<float32> Magnitudes)
+{
+    if(Magnitudes.empty())
+    {
+        return FEnvelopeThreshold{};
+    }
+
+    auto GetQuantile = [Magnitudes](const float32 Quantile) -> float32
+    {
+        const auto Element{Magnitudes.begin() + static_cast<std::ptrdiff_t>(Quantile * static_cast<float32>(Magnitudes.size() - 1))};
+        std::nth_element(Magnitudes.begin(), Element, Magnitudes.end());
+
+        return *Element;
+    };
+
+    const float32 InitialFloor{GetQuantile(Tone::SeedFloorQuantile)};
+
+    return FEnvelopeThreshold{InitialFloor, GetQuantile(Tone::SeedPeakQuantile)};
+}
+
+float32 DetectToneFrequency(const FPcmAudio& MonoAudio)
+{
+    const size_t WindowSamples{static_cast<size_t>(MonoAudio.SampleRate * Tone::ScanWindowSeconds)};
+    const size_t NumWindows{std::min(Tone::MaxScanWindows, MonoAudio.Samples.size() / std::max<size_t>(1, WindowSamples))};
+
+    if(NumWindows == 0)
+    {
+        return Tone::LowestCandidate;
+    }
+
+    std::array<Simd::float32_8, Tone::NumCandidateRegisters> Coefficients;
+    std::array<Simd::float32_8, Tone::NumCandidateRegisters> Powers;
+
+    Coefficients.fill(Simd::float32_8{0.f});
+    Powers.fill(Simd::float32_8{0.f});
+
+    for(size_t Register{0}; Register < Tone::NumCandidateRegisters; ++Register)
+    {
+        std::array<float32, Simd::float32_8::GetNumElements()> Lanes{};
+
+        for(size_t Lane{0}; Lane < Lanes.size(); ++Lane)
+        {
+            const float32 Frequency{Tone::LowestCandidate + Tone::CandidateStep * static_cast<float32>(Register * Lanes.size() + Lane)};
+            Lanes[Lane] = static_cast<float32>(2.0 * std::cos(2.0 * std::numbers::pi * Frequency / MonoAudio.SampleRate));
+        }
+
+        Coefficients[Register] = Simd::float32_8{_mm256_loadu_ps(Lanes.data())};
+    }
+
+    const size_t WindowStride{MonoAudio.Samples.size() / NumWindows};
+
+    for(size_t Window{0}; Window < NumWindows; ++Window)
+    {
+        std::array<Simd::float32_8, Tone::NumCandidateRegisters> Previous;
+        std::array<Simd::float32_8, Tone::NumCandidateRegisters> BeforePrevious;
+
+        Previous.fill(Simd::float32_8{0.f});
+        BeforePrevious.fill(Simd::float32_8{0.f});
+
+        const int16* Samples{&MonoAudio.Samples[Window * WindowStride]};
+
+        for(size_t Sample{0}; Sample < WindowSamples; ++Sample)
+        {
+            const Simd::float32_8 Input{static_cast<float32>(Samples[Sample])};
+
+            for(size_t Register{0}; Register < Tone::NumCandidateRegisters; ++Register)
+            {
+                const Simd::float32_8 Current{Simd::FusedMultiplyAdd(Coefficients[Register].Register, Previous[Register].Register, (Input - BeforePrevious[Register]).Register)};
+
+                BeforePrevious[Register] = Previous[Register];
+                Previous[Register] = Current;
+            }
+        }
+
+        for(size_t Register{0}; Register < Tone::NumCandidateRegisters; ++Register)
+        {
+            //|X|^2 = s1^2 + s2^2 - coefficient * s1 * s2
+            Powers[Register] += Previous[Register] * Previous[Register] + BeforePrevious[Register] * BeforePrevious[Register] - Coefficients[Register] * Previous[Register] * BeforePrevious[Register];
+        }
+    }
+
+    size_t BestCandidate{0};
+    float32 BestPower{-1.f};
+
+    for(size_t Register{0}; Register < Tone::NumCandidateRegisters; ++Register)
+    {
+        for(size_t Lane{0}; Lane < Simd::float32_8::GetNumElements(); ++Lane)
+        {
+            if(Powers[Register][Lane] > BestPower)
+            {
+                BestPower = Powers[Register][Lane];
+                BestCandidate = Register * Simd::float32_8::GetNumElements() + Lane;
+            }
+        }
+    }
+
+    return Tone::LowestCandidate + Tone::CandidateStep * static_cast<float32>(BestCandidate);
+}
+
+std::vector<char> DecodeEnvelope(const std::vector<float32>& Magnitudes, const size_t SamplesPerMagnitude, const uint32 SampleRate, const float32 InitialWpm)
+{
+    auto GetTimestamp = [SamplesPerMagnitude, SampleRate](const size_t Block) -> uint64
+    {
+        return static_cast<uint64>(Block) * SamplesPerMagnitude * 1000000 / SampleRate;
+    };
+
+    //even entries are key-down, odd ones key-up
+    std::vector<uint64> Transitions{};
+    std::vector<float32> Seed(Magnitudes.begin(), Magnitudes.begin() + std::min(Magnitudes.size(), Tone::NumSeedMagnitudes));
+    FEnvelopeThreshold Threshold{MakeSeededThreshold(Seed)};
+
+    for(size_t Block{0}; Block < Magnitudes.size(); ++Block)
+    {
+        if(Threshold.Update(Magnitudes[Block]) != (Transitions.size() % 2 == 1))
+        {
+            Transitions.emplace_back(GetTimestamp(Block));
+        }
+    }
+
+    if(Transitions.size() % 2 == 1)
+    {
+        Transitions.emplace_back(GetTimestamp(Magnitudes.size()));
+    }
+
+    std::vector<char> PlainTextVector{};
+
+    auto Append = [&PlainTextVector](const FKeyDecoderOutput& Output) -> void
+    {
+        PlainTextVector.insert(PlainTextVector.end(), Output.begin(), Output.end());
+    };
+
+    FAdaptiveKeyDecoder Decoder{InitialWpm > 0.f ? InitialWpm : Tone::EstimateWordsPerMinute(Transitions)};
+
+    for(size_t Transition{0}; Transition < Transitions.size(); ++Transition)
+    {
+        Append(Decoder.OnKeyEvent(Transitions[Transition], Transition % 2 == 0));
+    }
+
+    Append(Decoder.Flush());
+
+    return PlainTextVector;
+}
+
+std::vector<char> DecodeAudio(const FPcmAudio& Audio, const FToneDecoderSettings& Settings)
+{
+    const FPcmAudio MonoAudio{MixToMono(Audio)};
+
+    const float32 ToneFrequency{Settings.ToneFrequency > 0.f ? Settings.ToneFrequency : DetectToneFrequency(MonoAudio)};
+    const FToneDetector Detector{MonoAudio.SampleRate, ToneFrequency, Settings.BlockSeconds};
+
+    const size_t BlockSamples{Detector.GetBlockSamples()};
+    const size_t NumBlocks{MonoAudio.Samples.size() / BlockSamples};
+
+    //the filter has no state across blocks, so every core takes a contiguous share of the recording
+    std::vector<float32> Magnitudes(NumBlocks);
+    std::vector<std::thread> Workers{};
+
+    const size_t NumWorkers{std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(), NumBlocks / 1024))};
+
+    for(size_t Worker{0}; Worker < NumWorkers; ++Worker)
+    {
+        Workers.emplace_back([&Magnitudes, &Detector, &MonoAudio, BlockSamples, First = NumBlocks * Worker / NumWorkers, Last = NumBlocks * (Worker + 1) / NumWorkers]() -> void
+        {
+            for(size_t Block{First}; Block < Last; ++Block)
+            {
+                Magnitudes[Block] = Detector.GetMagnitude(&MonoAudio.Samples[Block * BlockSamples]);
+            }
+        });
+    }
+
+    for(std::thread& Worker : Workers)
+    {
+        Worker.join();
+    }
+
+    return DecodeEnvelope(Magnitudes, BlockSamples, MonoAudio.SampleRate, Settings.InitialWpm);
+}
+
+std::vector<char> DecodeAudioToPlainText(const std::string& PathToFile, const FToneDecoderSettings& Settings)
+{
+    const FPcmAudio Audio{ReadPcmAudio(PathToFile)};
+
+    if(Audio.Samples.empty())
+    {
+        return std::vector<char>{};
+    }
+
+    return DecodeAudio(Audio, Settings);
+}
@@ -0,0 +1,76 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "KeyEventDecoder.h"
+#include "WavFile.h"
+#include <span>
+
+struct FToneDecoderSettings
+{
+    //0 = scan 300-1570 Hz for the strongest tone
+    float32 ToneFrequency{0.f};
+    float32 BlockSeconds{0.005f};
+    //0 = estimated from the first key-down durations of the recording
+    float32 InitialWpm{0.f};
+};
+
+//magnitude of one frequency over a block of samples, the single bin a Goertzel filter computes,
+//done as contiguous multiply-adds against a precomputed carrier so eight samples go per instruction
+class FToneDetector final
+{
+public:
+
+    FToneDetector(uint32 SampleRate, float32 ToneFrequency, float32 BlockSeconds);
+
+    float32 GetMagnitude(const int16* Block) const;
+
+    size_t GetBlockSamples() const {return Cosines.size() * Simd::float32_8::GetNumElements();}
+
+private:
+
+    std::vector<Simd::float32_8> Cosines;
+    std::vector<Simd::float32_8> Sines;
+};
+
+//key-down/key-up decision against a noise floor and a peak that follow the recording, so fading and level changes need no fixed threshold
+class FEnvelopeThreshold final
+{
+public:
+
+    FEnvelopeThreshold() = default;
+
+    //starting from known levels skips the settling time in which noise can key
+    FEnvelopeThreshold(float32 InitialFloor, float32 InitialPeak);
+
+    bool Update(float32 Magnitude);
+
+private:
+
+    float32 Floor{0.f};
+    float32 Peak{0.f};
+    bool bKeyDown{false};
+};
+
+//starts a threshold at the noise and tone levels among the first magnitudes of a recording, Magnitudes is reordered
+FEnvelopeThreshold MakeSeededThreshold(std::span<float32> Magnitudes);
+
+//Goertzel over eight candidate frequencies per register, on windows spread across the whole recording
+float32 DetectToneFrequency(const FPcmAudio& MonoAudio);
+
+//thresholds a tone magnitude sequence into key transitions and decodes them, InitialWpm 0 estimates the speed from the first elements
+std::vector<char> DecodeEnvelope(const std::vector<float32>& Magnitudes, size_t SamplesPerMagnitude, uint32 SampleRate, float32 InitialWpm = 0.f);
+
+std::vector<char> DecodeAudio(const FPcmAudio& Audio, const FToneDecoderSettings& Settings = {});
+
+std::vector<char> DecodeAudioToPlainText(const std::string& PathToFile, const FToneDecoderSettings& Settings = {});
@@ -0,0 +1,200 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "WavFile.h"
+#include <string_view>
+
+namespace Wav
+{
+    template<typename IntegerType>
+    void WriteLittleEndian(std::fstream& FStream, const IntegerType Value)
+    {
+        for(size_t Byte{0}; Byte < sizeof(IntegerType); ++Byte)
+        {
+            FStream.put(static_cast<char>((Value >> (Byte * 8)) & 0xFF));
+        }
+    }
+
+    template<typename IntegerType>
+    IntegerType ReadLittleEndian(std::fstream& FStream)
+    {
+        IntegerType Value{0};
+
+        for(size_t Byte{0}; Byte < sizeof(IntegerType); ++Byte)
+        {
+            Value |= static_cast<IntegerType>(static_cast<uint8>(FStream.get())) << (Byte * 8);
+        }
+
+        return Value;
+    }
+
+    bool ReadChunkId(std::fstream& FStream, const std::string_view ExpectedId)
+    {
+        std::array<char, 4> ChunkId{};
+
+        return FStream.read(ChunkId.data(), ChunkId.size()) && std::string_view{ChunkId.data(), ChunkId.size()} == ExpectedId;
+    }
+}
+
+bool IsRawPcmPath(const std::string& Path)
+{
+    auto EndsWith = [&Path](const std::string& Suffix) -> bool
+    {
+        return Path.size() >= Suffix.size() && Path.compare(Path.size() - Suffix.size(), Suffix.size(), Suffix) == 0;
+    };
+
+    return EndsWith(".raw") || EndsWith(".pcm");
+}
+
+void WriteToFile(const std::string& PathToOutFile, const FPcmAudio& AudioToWrite)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToOutFile, std::ios::out | std::ios::binary);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToOutFile << std::endl;
+        return;
+    }
+
+    const uint32 DataBytes{static_cast<uint32>(AudioToWrite.Samples.size() * sizeof(int16))};
+
+    if(!IsRawPcmPath(PathToOutFile))
+    {
+        const uint16 BlockAlign{static_cast<uint16>(AudioToWrite.NumChannels * sizeof(int16))};
+
+        FStream.write("RIFF", 4);
+        Wav::WriteLittleEndian<uint32>(FStream, 36 + DataBytes);
+        FStream.write("WAVE", 4);
+
+        FStream.write("fmt ", 4);
+        Wav::WriteLittleEndian<uint32>(FStream, 16);
+        Wav::WriteLittleEndian<uint16>(FStream, 1);
+        Wav::WriteLittleEndian<uint16>(FStream, AudioToWrite.NumChannels);
+        Wav::WriteLittleEndian<uint32>(FStream, AudioToWrite.SampleRate);
+        Wav::WriteLittleEndian<uint32>(FStream, AudioToWrite.SampleRate * BlockAlign);
+        Wav::WriteLittleEndian<uint16>(FStream, BlockAlign);
+        Wav::WriteLittleEndian<uint16>(FStream, 16);
+
+        FStream.write("data", 4);
+        Wav::WriteLittleEndian<uint32>(FStream, DataBytes);
+    }
+
+    FStream.write(reinterpret_cast<const char*>(AudioToWrite.Samples.data()), DataBytes);
+
+    FStream.close();
+}
+
+FPcmAudio ReadPcmAudio(const std::string& PathToFile)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, std::ios::in | std::ios::binary);
+
+    FPcmAudio Audio{};
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return Audio;
+    }
+
+    if(IsRawPcmPath(PathToFile))
+    {
+        FStream.seekg(0, std::ios::end);
+        Audio.Samples.resize(static_cast<size_t>(FStream.tellg()) / sizeof(int16));
+        FStream.seekg(0, std::ios::beg);
+        FStream.read(reinterpret_cast<char*>(Audio.Samples.data()), static_cast<std::streamsize>(Audio.Samples.size() * sizeof(int16)));
+
+        return Audio;
+    }
+
+    const bool bRiff{Wav::ReadChunkId(FStream, "RIFF")};
+    Wav::ReadLittleEndian<uint32>(FStream);
+
+    if(!bRiff || !Wav::ReadChunkId(FStream, "WAVE"))
+    {
+        std::cerr << "Not a RIFF/WAVE file: " << PathToFile << std::endl;
+        return Audio;
+    }
+
+    uint16 BitsPerSample{0};
+
+    //chunks are walked in order, anything other than fmt and data (LIST, fact, ...) is skipped
+    for(std::array<char, 4> ChunkId{}; FStream.read(ChunkId.data(), ChunkId.size());)
+    {
+        const std::string_view Id{ChunkId.data(), ChunkId.size()};
+        const uint32 ChunkSize{Wav::ReadLittleEndian<uint32>(FStream)};
+
+        if(Id == "fmt ")
+        {
+            const uint16 FormatTag{Wav::ReadLittleEndian<uint16>(FStream)};
+            Audio.NumChannels = Wav::ReadLittleEndian<uint16>(FStream);
+            Audio.SampleRate = Wav::ReadLittleEndian<uint32>(FStream);
+            FStream.ignore(6);
+            BitsPerSample = Wav::ReadLittleEndian<uint16>(FStream);
+            FStream.ignore(ChunkSize - 16 + (ChunkSize & 1));
+
+            //1 = PCM, 0xFFFE = extensible, which is PCM as well for 16 bit
+            if((FormatTag != 1 && FormatTag != 0xFFFE) || BitsPerSample != 16 || Audio.NumChannels == 0)
+            {
+                std::cerr << "Only 16 bit PCM is supported: " << PathToFile << std::endl;
+                return FPcmAudio{};
+            }
+        }
+        else if(Id == "data" && BitsPerSample != 0)
+        {
+            Audio.Samples.resize(ChunkSize / sizeof(int16));
+            FStream.read(reinterpret_cast<char*>(Audio.Samples.data()), static_cast<std::streamsize>(Audio.Samples.size() * sizeof(int16)));
+            Audio.Samples.resize(static_cast<size_t>(FStream.gcount()) / sizeof(int16));
+
+            return Audio;
+        }
+        else
+        {
+            FStream.ignore(ChunkSize + (ChunkSize & 1));
+        }
+    }
+
+    std::cerr << "No audio data in file: " << PathToFile << std::endl;
+
+    return FPcmAudio{};
+}
+
+FPcmAudio MixToMono(const FPcmAudio& Audio)
+{
+    FPcmAudio Mono{};
+    Mono.SampleRate = Audio.SampleRate;
+
+    if(Audio.NumChannels <= 1)
+    {
+        Mono.Samples = Audio.Samples;
+        return Mono;
+    }
+
+    Mono.Samples.resize(Audio.Samples.size() / Audio.NumChannels);
+
+    for(size_t Frame{0}; Frame < Mono.Samples.size(); ++Frame)
+    {
+        int32 Sum{0};
+
+        for(size_t Channel{0}; Channel < Audio.NumChannels; ++Channel)
+        {
+            Sum += Audio.Samples[Frame * Audio.NumChannels + Channel];
+        }
+
+        Mono.Samples[Frame] = static_cast<int16>(Sum / Audio.NumChannels);
+    }
+
+    return Mono;
+}
@@ -0,0 +1,34 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "FileReader.h"
+
+//16 bit signed samples, interleaved when there is more than one channel
+struct FPcmAudio
+{
+    uint32 SampleRate{8000};
+    uint16 NumChannels{1};
+    std::vector<int16> Samples;
+};
+
+bool IsRawPcmPath(const std::string& Path);
+
+//paths ending in .raw or .pcm get the bare samples, anything else a RIFF/WAVE header in front of them
+void WriteToFile(const std::string& PathToOutFile, const FPcmAudio& AudioToWrite);
+
+//reads 16 bit PCM WAV files, .raw and .pcm paths are read as bare 8 kHz mono samples
+FPcmAudio ReadPcmAudio(const std::string& PathToFile);
+
+//averages interleaved channels into one
+FPcmAudio MixToMono(const FPcmAudio& Audio);
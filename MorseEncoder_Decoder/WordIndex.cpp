@@ -0,0 +1,397 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "WordIndex.h"
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace WordIndex
+{
+    constexpr size_t ReadChunkBytes{1 << 20};
+
+    //shares smaller than this are not worth a thread
+    constexpr uint64 MinShareBytes{1 << 20};
+
+    bool IsIgnorable(const char Character)
+    {
+        return Character == ' ' || Character == '\t' || Character == '\r' || Character == '\n';
+    }
+
+    //the sections a header points to have to lie in the file in their order, and every entry inside its section
+    bool HasValidLayout(const uint8* Data, const size_t NumBytes)
+    {
+        const FWordIndexHeader& Header{*reinterpret_cast<const FWordIndexHeader*>(Data)};
+
+        if(Header.Magic != FWordIndexHeader{}.Magic || Header.NumWords > (NumBytes - sizeof(FWordIndexHeader)) / sizeof(FWordIndexEntry))
+        {
+            return false;
+        }
+
+        if(Header.WordsOffset != sizeof(FWordIndexHeader) + Header.NumWords * sizeof(FWordIndexEntry) || Header.PostingsOffset < Header.WordsOffset || Header.PostingsOffset > NumBytes)
+        {
+            return false;
+        }
+
+        const FWordIndexEntry* const Entries{reinterpret_cast<const FWordIndexEntry*>(Data + sizeof(FWordIndexHeader))};
+
+        const uint64 NumWordBytes{Header.PostingsOffset - Header.WordsOffset};
+        const uint64 NumPostingBytes{NumBytes - Header.PostingsOffset};
+
+        //every posting takes at least one byte
+        return std::all_of(Entries, Entries + Header.NumWords, [NumWordBytes, NumPostingBytes](const FWordIndexEntry& Entry) -> bool
+        {
+            return uint64{Entry.WordOffset} + Entry.WordLength <= NumWordBytes && Entry.PostingsOffset <= NumPostingBytes && Entry.NumPostings <= NumPostingBytes - Entry.PostingsOffset;
+        });
+    }
+
+    struct FShare
+    {
+        uint64 NumCharacters{0};
+
+        //offsets are counted from the first character of the share until all shares are known
+        std::unordered_map<std::string, std::vector<uint64>> Postings{};
+    };
+
+    //decodes the words starting after the first | at or after First, up to and including the first | at or after Last
+    void IndexShare(const std::string& PathToFile, const uint64 First, const uint64 Last, FShare& OutShare)
+    {
+        std::fstream FStream{};
+
+        FStream.open(PathToFile, std::ios::in | std::ios::binary);
+        FStream.seekg(static_cast<std::streamoff>(First));
+
+        std::vector<char> Chunk(ReadChunkBytes);
+
+        std::string Word{};
+        uint64 WordStart{0};
+        uint32 PackedCode{1};
+
+        bool bSkipping{First > 0};
+
+        auto EndWord = [&]() -> void
+        {
+            if(!Word.empty())
+            {
+                OutShare.Postings[Word].emplace_back(WordStart);
+                Word.clear();
+            }
+        };
+
+        for(uint64 ChunkStart{First}; FStream.read(Chunk.data(), static_cast<std::streamsize>(Chunk.size())) || FStream.gcount() > 0; ChunkStart += static_cast<uint64>(FStream.gcount()))
+        {
+            const size_t NumRead{static_cast<size_t>(FStream.gcount())};
+
+            for(size_t Index{0}; Index < NumRead; ++Index)
+            {
+                const int16 Symbol{static_cast<int16>(static_cast<uint8>(Chunk[Index]))};
+
+                if(IsIgnorable(Chunk[Index]))
+                {
+                    continue;
+                }
+                else if(Symbol == MorseCodes::SeparateChar || Symbol == MorseCodes::NewWord)
+                {
+                    if(!bSkipping)
+                    {
+                        const char Character{GetCharacterFromPackedMorse(static_cast<uint16>(PackedCode))};
+
+                        if(Character == MorseCodes::Unrecognized)
+                        {
+                            EndWord();
+                        }
+                        else
+                        {
+                            WordStart = Word.empty() ? OutShare.NumCharacters : WordStart;
+                            Word.push_back(Character);
+                        }
+
+                        ++OutShare.NumCharacters;
+                    }
+
+                    PackedCode = 1;
+
+                    if(Symbol == MorseCodes::NewWord)
+                    {
+                        EndWord();
+                        bSkipping = false;
+
+                        if(ChunkStart + Index >= Last)
+                        {
+                            return;
+                        }
+                    }
+                }
+                else
+                {
+                    //like in -Decode, a byte that is no element makes its character Unrecognized, which ends the word
+                    PackedCode = AddElementToPackedMorse(PackedCode, Chunk[Index]);
+                }
+            }
+        }
+
+        EndWord();
+    }
+
+    void AppendVarint(std::vector<uint8>& Bytes, uint64 Value)
+    {
+        for(; Value >= 0x80; Value >>= 7)
+        {
+            Bytes.emplace_back(static_cast<uint8>(Value | 0x80));
+        }
+
+        Bytes.emplace_back(static_cast<uint8>(Value));
+    }
+}
+
+FWordIndex BuildWordIndex(const std::string& PathToFile)
+{
+    FWordIndex Index{};
+
+    std::fstream FStream{};
+
+    FStream.open(PathToFile, std::ios::in | std::ios::binary);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return Index;
+    }
+
+    FStream.seekg(0, std::ios::end);
+    const uint64 FileSize{static_cast<uint64>(FStream.tellg())};
+    FStream.close();
+
+    const size_t NumShares{std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(), FileSize / WordIndex::MinShareBytes))};
+
+    std::vector<WordIndex::FShare> Shares(NumShares);
+    std::vector<std::thread> Workers{};
+
+    for(size_t Share{0}; Share < NumShares; ++Share)
+    {
+        Workers.emplace_back(WordIndex::IndexShare, std::cref(PathToFile), FileSize * Share / NumShares, FileSize * (Share + 1) / NumShares, std::ref(Shares[Share]));
+    }
+
+    for(std::thread& Worker : Workers)
+    {
+        Worker.join();
+    }
+
+    //shares are merged in file order, so every posting list stays sorted
+    std::unordered_map<std::string, std::vector<uint64>> Postings{};
+
+    for(WordIndex::FShare& Share : Shares)
+    {
+        for(auto& [Word, Offsets] : Share.Postings)
+        {
+            std::vector<uint64>& Merged{Postings[Word]};
+
+            for(const uint64 Offset : Offsets)
+            {
+                Merged.emplace_back(Index.Header.NumCharacters + Offset);
+            }
+        }
+
+        Index.Header.NumCharacters += Share.NumCharacters;
+        Share.Postings.clear();
+    }
+
+    std::vector<const std::pair<const std::string, std::vector<uint64>>*> Sorted{};
+    Sorted.reserve(Postings.size());
+
+    for(const auto& WordAndOffsets : Postings)
+    {
+        Sorted.emplace_back(&WordAndOffsets);
+    }
+
+    std::sort(Sorted.begin(), Sorted.end(), [](const auto* A, const auto* B) -> bool {return A->first < B->first;});
+
+    for(const auto* WordAndOffsets : Sorted)
+    {
+        const auto& [Word, Offsets] = *WordAndOffsets;
+
+        Index.Entries.emplace_back(FWordIndexEntry{Index.Postings.size(), Offsets.size(), static_cast<uint32>(Index.Words.size()), static_cast<uint32>(Word.size())});
+        Index.Words += Word;
+
+        uint64 Previous{0};
+
+        for(const uint64 Offset : Offsets)
+        {
+            WordIndex::AppendVarint(Index.Postings, Offset - Previous);
+            Previous = Offset;
+        }
+    }
+
+    Index.Header.NumWords = static_cast<uint32>(Index.Entries.size());
+    Index.Header.WordsOffset = sizeof(FWordIndexHeader) + Index.Entries.size() * sizeof(FWordIndexEntry);
+    Index.Header.PostingsOffset = Index.Header.WordsOffset + Index.Words.size();
+
+    return Index;
+}
+
+void WriteToFile(const std::string& PathToOutFile, const FWordIndex& IndexToWrite)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToOutFile, std::ios::out | std::ios::binary);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToOutFile << std::endl;
+        return;
+    }
+
+    FStream.write(reinterpret_cast<const char*>(&IndexToWrite.Header), sizeof(FWordIndexHeader));
+    FStream.write(reinterpret_cast<const char*>(IndexToWrite.Entries.data()), static_cast<std::streamsize>(IndexToWrite.Entries.size() * sizeof(FWordIndexEntry)));
+    FStream.write(IndexToWrite.Words.data(), static_cast<std::streamsize>(IndexToWrite.Words.size()));
+    FStream.write(reinterpret_cast<const char*>(IndexToWrite.Postings.data()), static_cast<std::streamsize>(IndexToWrite.Postings.size()));
+
+    FStream.close();
+}
+
+void WriteToFile(const std::string& PathToOutFile, const std::vector<uint64>& OffsetsToWrite)
+{
+    std::fstream FStream{};
+
+    FStream.open(PathToOutFile, std::ios::out);
+
+    if(!FStream)
+    {
+        std::cerr << "Failed to open file with path: " << PathToOutFile << std::endl;
+        return;
+    }
+
+    for(const uint64 Offset : OffsetsToWrite)
+    {
+        FStream << Offset << "\n";
+    }
+
+    FStream.close();
+}
+
+FMappedWordIndex::FMappedWordIndex(const std::string& PathToFile)
+{
+    const int FileDescriptor{open(PathToFile.c_str(), O_RDONLY)};
+
+    if(FileDescriptor < 0)
+    {
+        std::cerr << "Failed to open file with path: " << PathToFile << std::endl;
+        return;
+    }
+
+    struct stat FileStatus{};
+
+    if(fstat(FileDescriptor, &FileStatus) == 0 && static_cast<size_t>(FileStatus.st_size) >= sizeof(FWordIndexHeader))
+    {
+        NumBytes = static_cast<size_t>(FileStatus.st_size);
+        Mapping = mmap(nullptr, NumBytes, PROT_READ, MAP_PRIVATE, FileDescriptor, 0);
+    }
+
+    //the mapping stays valid after the descriptor is gone
+    close(FileDescriptor);
+
+    if(Mapping == MAP_FAILED || Mapping == nullptr)
+    {
+        Mapping = nullptr;
+        std::cerr << "Failed to map file with path: " << PathToFile << std::endl;
+        return;
+    }
+
+    const uint8* Data{static_cast<const uint8*>(Mapping)};
+
+    if(!WordIndex::HasValidLayout(Data, NumBytes))
+    {
+        std::cerr << "Not a word index: " << PathToFile << std::endl;
+        return;
+    }
+
+    Header = reinterpret_cast<const FWordIndexHeader*>(Data);
+    Entries = reinterpret_cast<const FWordIndexEntry*>(Data + sizeof(FWordIndexHeader));
+    Words = reinterpret_cast<const char*>(Data + Header->WordsOffset);
+    Postings = Data + Header->PostingsOffset;
+}
+
+FMappedWordIndex::~FMappedWordIndex()
+{
+    if(Mapping != nullptr)
+    {
+        munmap(Mapping, NumBytes);
+    }
+}
+
+std::vector<uint64> FMappedWordIndex::Find(const std::string_view Word) const
+{
+    std::vector<uint64> Offsets{};
+
+    if(!IsValid())
+    {
+        return Offsets;
+    }
+
+    std::string UpperWord{Word};
+
+    for(char& Character : UpperWord)
+    {
+        Character -= 32 * (Character >= 'a' && Character <= 'z');
+    }
+
+    const FWordIndexEntry* const EntriesEnd{Entries + Header->NumWords};
+
+    const FWordIndexEntry* const Entry{std::lower_bound(Entries, EntriesEnd, std::string_view{UpperWord}, [this](const FWordIndexEntry& Candidate, const std::string_view Value) -> bool
+    {
+        return std::string_view{Words + Candidate.WordOffset, Candidate.WordLength} < Value;
+    })};
+
+    if(Entry == EntriesEnd || std::string_view{Words + Entry->WordOffset, Entry->WordLength} != UpperWord)
+    {
+        return Offsets;
+    }
+
+    Offsets.reserve(Entry->NumPostings);
+
+    const uint8* Position{Postings + Entry->PostingsOffset};
+    const uint8* const PostingsEnd{static_cast<const uint8*>(Mapping) + NumBytes};
+    uint64 Offset{0};
+
+    for(uint64 Posting{0}; Posting < Entry->NumPostings; ++Posting)
+    {
+        uint64 Delta{0};
+
+        for(uint32 Shift{0}; ; Shift += 7)
+        {
+            //a varint running off the file or past 64 bits is a damaged list, the offsets read so far are kept
+            if(Position == PostingsEnd || Shift >= 64)
+            {
+                std::cerr << "Damaged posting list of: " << UpperWord << std::endl;
+                return Offsets;
+            }
+
+            const uint8 Byte{*Position++};
+
+            Delta |= static_cast<uint64>(Byte & 0x7F) << Shift;
+
+            if(Byte < 0x80)
+            {
+                break;
+            }
+        }
+
+        Offset += Delta;
+        Offsets.emplace_back(Offset);
+    }
+
+    return Offsets;
+}
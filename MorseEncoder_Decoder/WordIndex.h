@@ -0,0 +1,89 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "FileReader.h"
+#include <string_view>
+
+//file layout: header, the entries sorted by word, the words back to back, then the posting lists.
+//a posting list holds the character offsets of a word as LEB128 varints, the first absolute and every later one as the distance to the previous
+struct FWordIndexHeader
+{
+    std::array<char, 4> Magic{'M', 'W', 'I', 'X'};
+    uint32 NumWords{0};
+    uint64 NumCharacters{0};
+    uint64 WordsOffset{0};
+    uint64 PostingsOffset{0};
+};
+
+static_assert(sizeof(FWordIndexHeader) == 32, "The header is written as it is laid out in memory");
+
+struct FWordIndexEntry
+{
+    //from the start of the posting lists
+    uint64 PostingsOffset;
+    uint64 NumPostings;
+
+    //from the start of the words
+    uint32 WordOffset;
+    uint32 WordLength;
+};
+
+static_assert(sizeof(FWordIndexEntry) == 24, "Entries are read in place from the mapped file");
+
+struct FWordIndex
+{
+    FWordIndexHeader Header{};
+    std::vector<FWordIndexEntry> Entries{};
+    std::string Words{};
+    std::vector<uint8> Postings{};
+};
+
+//words are the runs of recognized characters between | and unrecognized characters, blanks and line breaks are skipped like -Decode does.
+//an offset is the number of & and | in front of the word, the count -DecodeCharacters and -Search take, so the spaces -Decode writes after | are not counted.
+//every hardware thread decodes its own share of the file, shares are cut after a | so no word is split
+FWordIndex BuildWordIndex(const std::string& PathToFile);
+
+void WriteToFile(const std::string& PathToOutFile, const FWordIndex& IndexToWrite);
+
+//one offset per line
+void WriteToFile(const std::string& PathToOutFile, const std::vector<uint64>& OffsetsToWrite);
+
+//maps a file written by WriteToFile, lookups binary search the entries in place and only decode the one posting list.
+//a file whose sections or entries do not fit in it is rejected
+class FMappedWordIndex final
+{
+public:
+
+    explicit FMappedWordIndex(const std::string& PathToFile);
+
+    ~FMappedWordIndex();
+
+    FMappedWordIndex(const FMappedWordIndex&) = delete;
+    FMappedWordIndex& operator=(const FMappedWordIndex&) = delete;
+
+    bool IsValid() const {return Header != nullptr;}
+
+    //character offsets of every occurrence in ascending order, the word is matched case insensitively
+    std::vector<uint64> Find(std::string_view Word) const;
+
+private:
+
+    void* Mapping{nullptr};
+    size_t NumBytes{0};
+
+    const FWordIndexHeader* Header{nullptr};
+    const FWordIndexEntry* Entries{nullptr};
+    const char* Words{nullptr};
+    const uint8* Postings{nullptr};
+};
@@ -11,52 +11,459 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 #include "FileReader.h"
+#include "NoisyDecoder.h"
+#include "KeyingStream.h"
+#include "KeyEventDecoder.h"
+#include "AudioRenderer.h"
+#include "ToneDecoder.h"
+#include "LiveAudioDecoder.h"
+#include "Skimmer.h"
+#include "BlinkDecoder.h"
+#include "PackedMorse.h"
+#include "MorseSearch.h"
+#include "WordIndex.h"
+#include "RangeDecoder.h"
+#include "MorseNotation.h"
+#include "MorseValidator.h"
+#include "MorseAlphabet.h"
+#include "MorseSink.h"
+#include <cmath>
 int main(int Argc, char* Argv[])
 {
     if(std::string{Argv[1]} == "-Help" || std::string{Argv[1]} == "-help")
     {
-        std::cout << "<Input File> <-Decode/-Encode> <Output File> (optional) \n" << std::endl;
+        std::cout << "<Input File> <-Decode/-Encode> <Output File> (optional) <Notation> (optional, reads or writes that dialect)\n" << std::endl;
+        std::cout << "<Input File> -DecodeRepair <Output File> (optional)" << std::endl;
+        std::cout << "Decodes morse-code, replacing unknown codes with the closest valid character\n" << std::endl;
+        std::cout << "<Input File> -DecodeNoisy <Output File> (optional) <Language Model Corpus> (optional)" << std::endl;
+        std::cout << "Decodes corrupted morse-code and writes a confidence digit (0-9) per character to <Output File>.confidence\n" << std::endl;
+        std::cout << "<Input File> -EncodeKeying <Output File> (optional) <Character WPM> <Effective WPM> (optional, Farnsworth spacing)" << std::endl;
+        std::cout << "Encodes plain text as ITU timed on/off keying, one bit per dot length\n" << std::endl;
+        std::cout << "<Input File> -DecodeKeying <Output File> (optional) <Character WPM> <Effective WPM> (optional, Farnsworth spacing)" << std::endl;
+        std::cout << "Decodes an on/off keying stream written by -EncodeKeying\n" << std::endl;
+        std::cout << "<Input File> <-DecodeKeyEvents/-DecodeKeyEventsBinary> <Output File> (optional)" << std::endl;
+        std::cout << "Decodes key-down/key-up timestamps at any speed, <Input File> can be - for stdin or a FIFO, characters are printed as they complete\n" << std::endl;
+        std::cout << "<Input File> -EncodeAudio <Output File> <Sample Rate> <WPM> <Tone Frequency> (optional)" << std::endl;
+        std::cout << "Renders plain text as keyed sine-tone audio, <Output File> ending in .raw or .pcm gets bare 16 bit samples, anything else a WAV file\n" << std::endl;
+        std::cout << "<List File> -EncodeAudioBatch" << std::endl;
+        std::cout << "Renders every \"<Input File> <Output File>\" line of <List File> with default settings, using all cores\n" << std::endl;
+        std::cout << "<Input File> -DecodeAudio <Output File> (optional) <Tone Frequency> (optional, detected when left out)" << std::endl;
+        std::cout << "Decodes a recorded 16 bit WAV file, or .raw/.pcm 8 kHz mono samples, at any speed\n" << std::endl;
+        std::cout << "<Input File> -DecodeAudioLive <Output File> (optional) <Sample Rate> <Tone Frequency> <WPM> (optional)" << std::endl;
+        std::cout << "Decodes raw 16 bit mono PCM as it arrives, <Input File> can be - for stdin or a FIFO, the latency of every character is printed to stderr\n" << std::endl;
+        std::cout << "<Input File> -DecodeIq <Output File> (optional) <Sample Rate> (optional, for .raw/.pcm, default 192000)" << std::endl;
+        std::cout << "Finds every CW carrier in a stereo I/Q WAV or interleaved 16 bit I/Q file and decodes them all, one line per frequency\n" << std::endl;
+        std::cout << "<Input File> -DecodeBlink <Output File> <Width> <Height> <Frames Per Second>" << std::endl;
+        std::cout << "Decodes a blinking light from raw 8 bit grayscale frames stored back to back, the blinking region is found automatically\n" << std::endl;
+        std::cout << "<Input File> -PackMorse <Output File>" << std::endl;
+        std::cout << "Stores morse-code with 2 bits per symbol in indexed blocks\n" << std::endl;
+        std::cout << "<Input File> -UnpackMorse <Output File> (optional)" << std::endl;
+        std::cout << "Turns a file written by -PackMorse back into morse-code\n" << std::endl;
+        std::cout << "<Input File> -DecodePacked <Output File> (optional) <First Character> <Number Of Characters> (optional)" << std::endl;
+        std::cout << "Decodes a file written by -PackMorse, jumping straight to <First Character>\n" << std::endl;
+        std::cout << "<Input File> -Search <Output File> <Query>" << std::endl;
+        std::cout << "Finds plain text in a morse-code file without decoding it, one \"<Byte Offset> <Character Offset>\" line per match\n" << std::endl;
+        std::cout << "<Input File> -BuildIndex <Output File>" << std::endl;
+        std::cout << "Writes an inverted index of every word in a morse-code file, for repeated lookups with -QueryIndex\n" << std::endl;
+        std::cout << "<Index File> -QueryIndex <Output File> <Word>" << std::endl;
+        std::cout << "Looks a word up in a file written by -BuildIndex, one character offset per line\n" << std::endl;
+        std::cout << "<Input File> -DecodeBytes <Output File> <First Byte> <Number Of Bytes>" << std::endl;
+        std::cout << "Decodes only the characters starting in a byte range of a morse-code file, back to back ranges page through it\n" << std::endl;
+        std::cout << "<Input File> -DecodeCharacters <Output File> <First Character> <Number Of Characters>" << std::endl;
+        std::cout << "Decodes only a character range of a morse-code file\n" << std::endl;
+        std::cout << "<Input File> -Transcode <Output File> <From Notation> <To Notation>" << std::endl;
+        std::cout << "Converts morse-code between dialects\n" << std::endl;
+        std::cout << "<Input File> -Validate <Output File> (optional) <strict/skip/report> (optional, default report)" << std::endl;
+        std::cout << "Lists invalid bytes and over-long codes by byte offset, strict stops at the first one, skip writes the input without them to <Output File> and the list to <Output File>.errors\n" << std::endl;
+        std::cout << "<Input File> <-EncodeWith/-DecodeWith> <Output File> <Alphabet>" << std::endl;
+        std::cout << "Encodes or decodes UTF-8 text with latin, cyrillic, greek, hebrew, arabic or wabun, or with the characters of an alphabet file,\none \"<Character> <Pattern>\" line each like \"A .-\", compiled once into <Alphabet>.cache\n" << std::endl;
         std::cout << "Morse-code is written as * = short, - = long, & = new character, | = new word\n" << std::endl;
-        std::cout << "Example input code: ....<....|....|....<....|....|" << std::endl;
+        std::cout << "<Notation> is native, dots (. - space \" / \"), unicode (U+00B7 U+2212 space \" / \") or four comma separated tokens: short,long,new character,new word\n" << std::endl;
+        std::cout << "Example input code: ****&*&*-**&*-**&---|*--&---&*-*&*-**&-**|" << std::endl;
         return 0;
     }
 
-    if(Argc <= 3)
+    //the only command that prints as it decodes, so the stdout and file outputs share one branch
+    if(Argc > 2 && std::string{Argv[2]} == "-DecodeAudioLive")
     {
-        auto OutputAll = [](const std::vector<char>& Vector) -> void
+        std::fstream FStream{};
+
+        if(std::string{Argv[1]} != "-")
         {
-            for(const char Character : Vector)
+            FStream.open(Argv[1], std::ios::in | std::ios::binary);
+
+            if(!FStream)
             {
-                if(Character != '#')
-                {
-                    std::cout << Character;
-                }
+                std::cerr << "Failed to open file with path: " << Argv[1] << std::endl;
+                return 1;
             }
+        }
+
+        const bool bToFile{Argc > 3};
+
+        const uint32 SampleRate{Argc > 4 ? static_cast<uint32>(std::stoul(Argv[4])) : FLiveAudioDecoder::DefaultSampleRate};
+        const float32 ToneFrequency{Argc > 5 ? std::stof(Argv[5]) : FLiveAudioDecoder::DefaultToneFrequency};
+        const float32 Wpm{Argc > 6 ? std::stof(Argv[6]) : FLiveAudioDecoder::DefaultWpm};
+
+        std::vector<char> PlainTextVector{};
+
+        FLiveAudioDecoder Decoder{SampleRate, ToneFrequency, Wpm};
+
+        uint64 MaxLatency{0};
+        uint64 SumLatency{0};
+        uint64 NumCharacters{0};
+
+        ForEachLiveAudioCharacter(std::string{Argv[1]} == "-" ? std::cin : FStream, Decoder, [&](const char Character, const uint64 LatencyMicroseconds) -> void
+        {
+            if(bToFile)
+            {
+                PlainTextVector.emplace_back(Character);
+            }
+            else if(Character != MorseCodes::Unrecognized)
+            {
+                std::cout << Character << std::flush;
+            }
+
+            if(Character != ' ')
+            {
+                std::cerr << Character << " " << LatencyMicroseconds / 1000 << " ms" << std::endl;
+
+                MaxLatency = std::max(MaxLatency, LatencyMicroseconds);
+                SumLatency += LatencyMicroseconds;
+                ++NumCharacters;
+            }
+        });
+        std::cerr << Decoder.GetWordsPerMinute() << " WPM, latency mean " << (NumCharacters > 0 ? SumLatency / NumCharacters / 1000 : 0) << " ms, max " << MaxLatency / 1000 << " ms" << std::endl;
+
+        if(bToFile)
+        {
+            WriteToFile(std::string{Argv[3]}, PlainTextVector);
+        }
+
+        return 0;
+    }
+
+    if(Argc <= 3)
+    {
+        FStreamSink Sink{std::cout};
+
+        auto OutputAll = [&Sink](const std::vector<char>& Vector) -> void
+        {
+            WritePlainText(Vector.data(), Vector.size(), Sink);
             std::cout << std::endl;
         };
 
-        if(std::string{Argv[2]} == "-Decode")
+        if(std::string{Argv[2]} == "-Decode" || std::string{Argv[2]} == "-DecodeRepair")
         {
-            OutputAll(DecodeMorseToPlainText(std::string{Argv[1]}));
+            DecodeMorseToStream(std::string{Argv[1]}, std::cout, std::string{Argv[2]} == "-DecodeRepair");
+            std::cout << std::endl;
         }
         else if(std::string{Argv[2]} == "-Encode")
         {
-            ForEachValidElementInRegisters(EncodePlainTextToMorse(std::string{Argv[1]}), [](const uint16 Character) -> void
+            EncodePlainTextToStream(std::string{Argv[1]}, std::cout);
+            std::cout << std::endl;
+        }
+        else if(std::string{Argv[2]} == "-Validate")
+        {
+            const FValidationResult Result{ValidateMorseText(std::string{Argv[1]}, EValidationPolicy::Report)};
+
+            for(const FMorseError& Error : Result.Errors)
             {
-                std::cout << static_cast<char>(Character);
-            });
+                std::cout << Error.ByteOffset << (Error.Kind == EMorseError::InvalidByte ? " invalid byte" : " over-long code") << "\n";
+            }
+
+            return Result.Errors.empty() ? 0 : 1;
+        }
+        else if(std::string{Argv[2]} == "-DecodeNoisy")
+        {
+            const FCharacterLanguageModel LanguageModel{};
+            const FNoisyDecodeResult Result{FNoisyMorseDecoder{LanguageModel}.Decode(std::string{Argv[1]})};
+
+            OutputAll(Result.PlainText);
+            OutputAll(FormatConfidence(Result.Confidence));
+        }
+        else if(std::string{Argv[2]} == "-EncodeKeying")
+        {
+            const FKeyingStream Stream{EncodePlainTextToKeying(std::string{Argv[1]})};
+
+            for(uint64 Unit{0}; Unit < Stream.NumUnits; ++Unit)
+            {
+                std::cout << ((Stream.Words[Unit / 64] >> (Unit % 64)) & 1);
+            }
             std::cout << std::endl;
         }
+        else if(std::string{Argv[2]} == "-DecodeKeying")
+        {
+            OutputAll(DecodeKeyingToPlainText(std::string{Argv[1]}));
+        }
+        else if(std::string{Argv[2]} == "-DecodeKeyEvents" || std::string{Argv[2]} == "-DecodeKeyEventsBinary")
+        {
+            const EKeyEventFormat Format{std::string{Argv[2]} == "-DecodeKeyEvents" ? EKeyEventFormat::Text : EKeyEventFormat::Binary};
+
+            std::fstream FStream{};
+
+            if(std::string{Argv[1]} != "-")
+            {
+                FStream.open(Argv[1], Format == EKeyEventFormat::Binary ? std::ios::in | std::ios::binary : std::ios::in);
+
+                if(!FStream)
+                {
+                    std::cerr << "Failed to open file with path: " << Argv[1] << std::endl;
+                    return 1;
+                }
+            }
+
+            FAdaptiveKeyDecoder Decoder{};
+
+            ForEachDecodedKeyEventCharacter(std::string{Argv[1]} == "-" ? std::cin : FStream, Format, Decoder, [](const char Character) -> void
+            {
+                if(Character != MorseCodes::Unrecognized)
+                {
+                    std::cout << Character << std::flush;
+                }
+            });
+            std::cout << "\n" << Decoder.GetWordsPerMinute() << " WPM" << std::endl;
+        }
+        else if(std::string{Argv[2]} == "-DecodeAudio")
+        {
+            OutputAll(DecodeAudioToPlainText(std::string{Argv[1]}));
+        }
+        else if(std::string{Argv[2]} == "-DecodeIq")
+        {
+            for(const FSkimmerChannel& Channel : DecodeIqToPlainText(std::string{Argv[1]}, 192000))
+            {
+                std::cout << std::lround(Channel.FrequencyHz) << " Hz: ";
+                OutputAll(Channel.PlainText);
+            }
+        }
+        else if(std::string{Argv[2]} == "-UnpackMorse")
+        {
+            OutputAll(UnpackMorseText(std::string{Argv[1]}));
+        }
+        else if(std::string{Argv[2]} == "-DecodePacked")
+        {
+            OutputAll(DecodePackedMorseToPlainText(std::string{Argv[1]}));
+        }
+        else if(std::string{Argv[2]} == "-EncodeAudioBatch")
+        {
+            std::fstream FStream{};
+
+            FStream.open(Argv[1], std::ios::in);
+
+            if(!FStream)
+            {
+                std::cerr << "Failed to open file with path: " << Argv[1] << std::endl;
+                return 1;
+            }
+
+            std::vector<std::pair<std::string, std::string>> InputOutputPaths{};
+            std::string InputPath{};
+            std::string OutputPath{};
+
+            while(FStream >> InputPath >> OutputPath)
+            {
+                InputOutputPaths.emplace_back(InputPath, OutputPath);
+            }
+
+            EncodePlainTextFilesToAudio(InputOutputPaths);
+        }
     }
     else
     {
-        if(std::string{Argv[2]} == "-Decode")
+        if(std::string{Argv[2]} == "-Decode" && Argc > 4)
         {
-            WriteToFile(std::string{Argv[3]}, DecodeMorseToPlainText(std::string{Argv[1]}));
+            FMorseNotation Notation{};
+
+            if(ParseMorseNotation(Argv[4], Notation))
+            {
+                WriteToFile(std::string{Argv[3]}, DecodeMorseToPlainText(std::string{Argv[1]}, Notation));
+            }
         }
-        else if(std::string{Argv[2]} == "-Encode")
+        else if(std::string{Argv[2]} == "-Encode" && Argc > 4)
+        {
+            FMorseNotation Notation{};
+
+            if(ParseMorseNotation(Argv[4], Notation))
+            {
+                WriteToFile(std::string{Argv[3]}, EncodePlainTextToMorse(std::string{Argv[1]}), Notation);
+            }
+        }
+        else if(std::string{Argv[2]} == "-Decode" || std::string{Argv[2]} == "-DecodeRepair" || std::string{Argv[2]} == "-Encode")
+        {
+            std::fstream OutStream{};
+
+            OutStream.open(std::string{Argv[3]}, std::ios::out);
+
+            if(!OutStream)
+            {
+                std::cerr << "Failed to open file with path: " << Argv[3] << std::endl;
+                return 1;
+            }
+
+            if(std::string{Argv[2]} == "-Encode")
+            {
+                EncodePlainTextToStream(std::string{Argv[1]}, OutStream);
+            }
+            else
+            {
+                DecodeMorseToStream(std::string{Argv[1]}, OutStream, std::string{Argv[2]} == "-DecodeRepair");
+            }
+        }
+        else if(std::string{Argv[2]} == "-Transcode" && Argc > 5)
+        {
+            FMorseNotation From{};
+            FMorseNotation To{};
+
+            if(ParseMorseNotation(Argv[4], From) && ParseMorseNotation(Argv[5], To))
+            {
+                WriteToFile(std::string{Argv[3]}, TranscodeMorseFile(std::string{Argv[1]}, From, To));
+            }
+        }
+        else if((std::string{Argv[2]} == "-EncodeWith" || std::string{Argv[2]} == "-DecodeWith") && Argc > 4)
+        {
+            FMorseAlphabet Alphabet{};
+
+            if(!ParseMorseAlphabet(Argv[4], Alphabet))
+            {
+                return 1;
+            }
+
+            if(std::string{Argv[2]} == "-EncodeWith")
+            {
+                WriteToFile(std::string{Argv[3]}, EncodePlainTextToMorse(std::string{Argv[1]}, Alphabet));
+            }
+            else
+            {
+                WriteToFile(std::string{Argv[3]}, DecodeMorseToPlainText(std::string{Argv[1]}, Alphabet));
+            }
+        }
+        else if(std::string{Argv[2]} == "-Validate")
+        {
+            const std::string PolicyName{Argc > 4 ? Argv[4] : "report"};
+            const EValidationPolicy Policy{PolicyName == "strict" ? EValidationPolicy::Strict : PolicyName == "skip" ? EValidationPolicy::Skip : EValidationPolicy::Report};
+
+            const FValidationResult Result{ValidateMorseText(std::string{Argv[1]}, Policy)};
+
+            if(Policy == EValidationPolicy::Skip)
+            {
+                WriteToFile(std::string{Argv[3]}, Result.MorseText);
+                WriteToFile(std::string{Argv[3]} + ".errors", Result.Errors);
+            }
+            else
+            {
+                WriteToFile(std::string{Argv[3]}, Result.Errors);
+            }
+
+            return Result.Errors.empty() ? 0 : 1;
+        }
+        else if(std::string{Argv[2]} == "-DecodeNoisy")
+        {
+            FCharacterLanguageModel LanguageModel{};
+
+            if(Argc > 4)
+            {
+                LanguageModel.Train(std::string{Argv[4]});
+            }
+
+            const FNoisyDecodeResult Result{FNoisyMorseDecoder{LanguageModel}.Decode(std::string{Argv[1]})};
+
+            WriteToFile(std::string{Argv[3]}, Result.PlainText);
+            WriteToFile(std::string{Argv[3]} + ".confidence", FormatConfidence(Result.Confidence));
+        }
+        else if(std::string{Argv[2]} == "-EncodeKeying")
+        {
+            const FKeyingTiming Timing{Argc > 5 ? FKeyingTiming::Farnsworth(std::stof(Argv[4]), std::stof(Argv[5])) : FKeyingTiming{}};
+
+            WriteToFile(std::string{Argv[3]}, EncodePlainTextToKeying(std::string{Argv[1]}, Timing));
+        }
+        else if(std::string{Argv[2]} == "-DecodeKeying")
+        {
+            const FKeyingTiming Timing{Argc > 5 ? FKeyingTiming::Farnsworth(std::stof(Argv[4]), std::stof(Argv[5])) : FKeyingTiming{}};
+
+            WriteToFile(std::string{Argv[3]}, DecodeKeyingToPlainText(std::string{Argv[1]}, Timing));
+        }
+        else if(std::string{Argv[2]} == "-DecodeKeyEvents" || std::string{Argv[2]} == "-DecodeKeyEventsBinary")
+        {
+            const EKeyEventFormat Format{std::string{Argv[2]} == "-DecodeKeyEvents" ? EKeyEventFormat::Text : EKeyEventFormat::Binary};
+
+            WriteToFile(std::string{Argv[3]}, DecodeKeyEventsToPlainText(std::string{Argv[1]}, Format));
+        }
+        else if(std::string{Argv[2]} == "-EncodeAudio")
+        {
+            FToneSettings Settings{};
+
+            if(Argc > 4)
+            {
+                Settings.SampleRate = static_cast<uint32>(std::stoul(Argv[4]));
+            }
+            if(Argc > 5)
+            {
+                Settings.Wpm = std::stof(Argv[5]);
+            }
+            if(Argc > 6)
+            {
+                Settings.ToneFrequency = std::stof(Argv[6]);
+            }
+
+            WriteToFile(std::string{Argv[3]}, EncodePlainTextToAudio(std::string{Argv[1]}, Settings));
+        }
+        else if(std::string{Argv[2]} == "-DecodeAudio")
+        {
+            FToneDecoderSettings Settings{};
+
+            if(Argc > 4)
+            {
+                Settings.ToneFrequency = std::stof(Argv[4]);
+            }
+
+            WriteToFile(std::string{Argv[3]}, DecodeAudioToPlainText(std::string{Argv[1]}, Settings));
+        }
+        else if(std::string{Argv[2]} == "-DecodeIq")
+        {
+            WriteToFile(std::string{Argv[3]}, DecodeIqToPlainText(std::string{Argv[1]}, Argc > 4 ? static_cast<uint32>(std::stoul(Argv[4])) : 192000));
+        }
+        else if(std::string{Argv[2]} == "-PackMorse")
+        {
+            WriteToFile(std::string{Argv[3]}, PackMorseText(std::string{Argv[1]}));
+        }
+        else if(std::string{Argv[2]} == "-UnpackMorse")
+        {
+            WriteToFile(std::string{Argv[3]}, UnpackMorseText(std::string{Argv[1]}));
+        }
+        else if(std::string{Argv[2]} == "-DecodePacked")
+        {
+            const uint64 FirstCharacter{Argc > 4 ? std::stoull(Argv[4]) : 0};
+            const uint64 NumCharacters{Argc > 5 ? std::stoull(Argv[5]) : std::numeric_limits<uint64>::max()};
+
+            WriteToFile(std::string{Argv[3]}, DecodePackedMorseToPlainText(std::string{Argv[1]}, FirstCharacter, NumCharacters));
+        }
+        else if(std::string{Argv[2]} == "-DecodeBlink" && Argc > 6)
+        {
+            const FFrameFormat Format{static_cast<uint32>(std::stoul(Argv[4])), static_cast<uint32>(std::stoul(Argv[5])), std::stof(Argv[6])};
+
+            WriteToFile(std::string{Argv[3]}, DecodeBlinkFramesToPlainText(std::string{Argv[1]}, Format));
+        }
+        else if(std::string{Argv[2]} == "-Search" && Argc > 4)
+        {
+            WriteToFile(std::string{Argv[3]}, SearchMorse(std::string{Argv[1]}, Argv[4]));
+        }
+        else if(std::string{Argv[2]} == "-BuildIndex")
+        {
+            WriteToFile(std::string{Argv[3]}, BuildWordIndex(std::string{Argv[1]}));
+        }
+        else if(std::string{Argv[2]} == "-QueryIndex" && Argc > 4)
+        {
+            const FMappedWordIndex Index{std::string{Argv[1]}};
+
+            WriteToFile(std::string{Argv[3]}, Index.Find(Argv[4]));
+        }
+        else if(std::string{Argv[2]} == "-DecodeBytes" && Argc > 5)
+        {
+            WriteToFile(std::string{Argv[3]}, DecodeMorseByteRangeToPlainText(std::string{Argv[1]}, std::stoull(Argv[4]), std::stoull(Argv[5])));
+        }
+        else if(std::string{Argv[2]} == "-DecodeCharacters" && Argc > 5)
         {
-            WriteToFile(std::string{Argv[3]}, EncodePlainTextToMorse(std::string{Argv[1]}));
+            WriteToFile(std::string{Argv[3]}, DecodeMorseCharacterRangeToPlainText(std::string{Argv[1]}, std::stoull(Argv[4]), std::stoull(Argv[5])));
         }
     }
 